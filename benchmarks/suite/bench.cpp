@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/sorters.h>
+#include <cpp-sort/utility/functional.h>
+#include "../benchmarking-tools/distributions.h"
+
+////////////////////////////////////////////////////////////
+// Benchmark suite
+//
+// Every sorter of the library is benchmarked against every
+// distribution, for several types and collection sizes. Every
+// benchmark is registered as sorter/type/distribution/size,
+// which allows to select a subset of them with the option
+// --benchmark_filter, and the results can be saved as JSON
+// with --benchmark_out=<file> --benchmark_out_format=json in
+// order to be compared across commits with compare.py.
+//
+// The sizes to benchmark can be changed with the option
+// --sizes=<size>,<size>,...
+
+namespace
+{
+    // Fixed seed: the distributions relying on randomness must
+    // produce the same collections across runs for the results
+    // of different commits to be comparable
+    constexpr std::mt19937_64::result_type seed = 0xC0FFEE;
+
+    // Default sizes of the collections to sort
+    const std::vector<long long int> default_sizes = { 1'000, 100'000 };
+
+    // Quadratic sorters are not benchmarked past this size
+    constexpr long long int max_quadratic_size = 1 << 14;
+
+    ////////////////////////////////////////////////////////////
+    // Types to sort
+
+    // Expensive to move type
+    struct large_value
+    {
+        long long int key;
+        std::array<long long int, 15> payload;
+
+        friend auto operator<(const large_value& lhs, const large_value& rhs)
+            -> bool
+        {
+            return lhs.key < rhs.key;
+        }
+    };
+
+    struct as_large_value:
+        cppsort::utility::projection_base
+    {
+        auto operator()(long long int value) const
+            -> large_value
+        {
+            large_value res;
+            res.key = value;
+            res.payload.fill(value);
+            return res;
+        }
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Benchmark function
+
+    template<typename Sorter, typename T, typename Distribution, typename Projection>
+    auto sort_benchmark(benchmark::State& state, Distribution distribution, Projection projection)
+        -> void
+    {
+        auto size = state.range(0);
+
+        std::vector<T> original;
+        original.reserve(size);
+        distributions_prng.seed(seed);
+        distribution(std::back_inserter(original), size, projection);
+
+        std::vector<T> collection;
+        for (auto _: state) {
+            state.PauseTiming();
+            collection = original;
+            state.ResumeTiming();
+            Sorter{}(collection);
+            benchmark::ClobberMemory();
+        }
+
+        if (not std::is_sorted(collection.begin(), collection.end())) {
+            state.SkipWithError("the collection was not sorted");
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Registration of the benchmarks
+
+    template<typename T, typename Projection>
+    struct benchmark_registry
+    {
+        const char* type_name;
+        Projection projection;
+        const std::vector<long long int>& sizes;
+
+        template<typename Sorter>
+        auto add_sorter(const char* sorter_name, long long int max_size=-1) const
+            -> void
+        {
+            // Only register the sorters that can sort T
+            using iterator = typename std::vector<T>::iterator;
+            add_sorter<Sorter>(sorter_name, max_size,
+                               cppsort::is_sorter_iterator<Sorter, iterator>{});
+        }
+
+        template<typename Sorter>
+        auto add_sorter(const char* sorter_name, long long int max_size, std::true_type) const
+            -> void
+        {
+            add_distribution<Sorter>(sorter_name, "shuffled", dist::shuffled{}, max_size);
+            add_distribution<Sorter>(sorter_name, "shuffled_16_values", dist::shuffled_16_values{}, max_size);
+            add_distribution<Sorter>(sorter_name, "all_equal", dist::all_equal{}, max_size);
+            add_distribution<Sorter>(sorter_name, "ascending", dist::ascending{}, max_size);
+            add_distribution<Sorter>(sorter_name, "descending", dist::descending{}, max_size);
+            add_distribution<Sorter>(sorter_name, "pipe_organ", dist::pipe_organ{}, max_size);
+            add_distribution<Sorter>(sorter_name, "push_front", dist::push_front{}, max_size);
+            add_distribution<Sorter>(sorter_name, "push_middle", dist::push_middle{}, max_size);
+            add_distribution<Sorter>(sorter_name, "ascending_sawtooth", dist::ascending_sawtooth{}, max_size);
+            add_distribution<Sorter>(sorter_name, "ascending_sawtooth_bad", dist::ascending_sawtooth_bad{}, max_size);
+            add_distribution<Sorter>(sorter_name, "descending_sawtooth", dist::descending_sawtooth{}, max_size);
+            add_distribution<Sorter>(sorter_name, "descending_sawtooth_bad", dist::descending_sawtooth_bad{}, max_size);
+            add_distribution<Sorter>(sorter_name, "alternating", dist::alternating{}, max_size);
+            add_distribution<Sorter>(sorter_name, "reversed_alternating", dist::reversed_alternating{}, max_size);
+            add_distribution<Sorter>(sorter_name, "descending_plateau", dist::descending_plateau{}, max_size);
+            add_distribution<Sorter>(sorter_name, "inversions_1%", dist::inversions(0.01), max_size);
+            // vergesort_killer doesn't work with small collections
+            add_distribution<Sorter>(sorter_name, "vergesort_killer", dist::vergesort_killer{}, max_size, 1'000);
+        }
+
+        template<typename Sorter>
+        auto add_sorter(const char*, long long int, std::false_type) const
+            -> void
+        {}
+
+        template<typename Sorter, typename Distribution>
+        auto add_distribution(const char* sorter_name, const char* distribution_name,
+                              Distribution distribution,
+                              long long int max_size, long long int min_size=0) const
+            -> void
+        {
+            auto first_size = std::find_if(sizes.begin(), sizes.end(), [&](long long int size) {
+                return size >= min_size && (max_size < 0 || size <= max_size);
+            });
+            if (first_size == sizes.end()) {
+                // A benchmark without sizes would be run without arguments
+                return;
+            }
+
+            auto name = std::string(sorter_name) + '/' + type_name + '/' + distribution_name;
+            auto bench = benchmark::RegisterBenchmark(
+                name.c_str(),
+                sort_benchmark<Sorter, T, Distribution, Projection>,
+                distribution, projection
+            );
+            bench->Unit(benchmark::kMicrosecond);
+            for (auto it = first_size; it != sizes.end(); ++it) {
+                if (*it >= min_size && (max_size < 0 || *it <= max_size)) {
+                    bench->Arg(*it);
+                }
+            }
+        }
+    };
+
+    template<typename T, typename Projection=cppsort::utility::identity>
+    auto register_benchmarks(const char* type_name, const std::vector<long long int>& sizes,
+                             Projection projection={})
+        -> void
+    {
+        benchmark_registry<T, Projection> registry = { type_name, projection, sizes };
+
+        registry.template add_sorter<cppsort::adaptive_shivers_sorter>("adaptive_shivers_sorter");
+        registry.template add_sorter<cppsort::auto_sorter>("auto_sorter");
+        registry.template add_sorter<cppsort::block_sorter<>>("block_sorter");
+        registry.template add_sorter<cppsort::cartesian_tree_sorter>("cartesian_tree_sorter");
+        registry.template add_sorter<cppsort::counting_sorter>("counting_sorter");
+        registry.template add_sorter<cppsort::d_ary_heap_sorter<4>>("d_ary_heap_sorter<4>");
+        registry.template add_sorter<cppsort::drop_merge_sorter>("drop_merge_sorter");
+        registry.template add_sorter<cppsort::grail_sorter<>>("grail_sorter");
+        registry.template add_sorter<cppsort::heap_sorter>("heap_sorter");
+        registry.template add_sorter<cppsort::insertion_sorter>("insertion_sorter", max_quadratic_size);
+        registry.template add_sorter<cppsort::lsd_radix_sorter<>>("lsd_radix_sorter");
+        registry.template add_sorter<cppsort::mel_sorter>("mel_sorter");
+        registry.template add_sorter<cppsort::merge_insertion_sorter>("merge_insertion_sorter");
+        registry.template add_sorter<cppsort::merge_sorter>("merge_sorter");
+        registry.template add_sorter<cppsort::multikey_quick_sorter>("multikey_quick_sorter");
+        registry.template add_sorter<cppsort::parallel_counting_sorter>("parallel_counting_sorter");
+        registry.template add_sorter<cppsort::parallel_grail_sorter<>>("parallel_grail_sorter");
+        registry.template add_sorter<cppsort::parallel_merge_sorter>("parallel_merge_sorter");
+        registry.template add_sorter<cppsort::parallel_pdq_sorter>("parallel_pdq_sorter");
+        registry.template add_sorter<cppsort::parallel_ska_sorter>("parallel_ska_sorter");
+        registry.template add_sorter<cppsort::parallel_spin_sorter>("parallel_spin_sorter");
+        registry.template add_sorter<cppsort::parallel_spread_sorter>("parallel_spread_sorter");
+        registry.template add_sorter<cppsort::parallel_tim_sorter>("parallel_tim_sorter");
+        registry.template add_sorter<cppsort::parallel_verge_sorter>("parallel_verge_sorter");
+        registry.template add_sorter<cppsort::parallel_wiki_sorter<>>("parallel_wiki_sorter");
+        registry.template add_sorter<cppsort::pdq_sorter>("pdq_sorter");
+        registry.template add_sorter<cppsort::poplar_sorter>("poplar_sorter");
+        registry.template add_sorter<cppsort::quick_merge_sorter>("quick_merge_sorter");
+        registry.template add_sorter<cppsort::quick_sorter>("quick_sorter");
+        registry.template add_sorter<cppsort::selection_sorter>("selection_sorter", max_quadratic_size);
+        registry.template add_sorter<cppsort::ska_sorter>("ska_sorter");
+        registry.template add_sorter<cppsort::slab_sorter>("slab_sorter");
+        registry.template add_sorter<cppsort::smooth_sorter>("smooth_sorter");
+        registry.template add_sorter<cppsort::spin_sorter>("spin_sorter");
+        registry.template add_sorter<cppsort::split_sorter>("split_sorter");
+        registry.template add_sorter<cppsort::spread_sorter>("spread_sorter");
+        registry.template add_sorter<cppsort::std_sorter>("std_sorter");
+        registry.template add_sorter<cppsort::tim_sorter>("tim_sorter");
+        registry.template add_sorter<cppsort::verge_sorter>("verge_sorter");
+        registry.template add_sorter<cppsort::wiki_sorter<>>("wiki_sorter");
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Command line handling
+
+    // Reads and removes the --sizes option from the command line
+    auto parse_sizes(int& argc, char** argv)
+        -> std::vector<long long int>
+    {
+        static constexpr char option[] = "--sizes=";
+        std::vector<long long int> sizes = default_sizes;
+
+        for (int idx = 1; idx < argc; ++idx) {
+            if (std::strncmp(argv[idx], option, sizeof(option) - 1) != 0) {
+                continue;
+            }
+
+            sizes.clear();
+            const char* str = argv[idx] + sizeof(option) - 1;
+            while (*str != '\0') {
+                char* end;
+                auto size = std::strtoll(str, &end, 10);
+                if (end == str || size <= 0) {
+                    std::cerr << "invalid value for --sizes: " << argv[idx] << '\n';
+                    std::exit(EXIT_FAILURE);
+                }
+                sizes.push_back(size);
+                str = *end == ',' ? end + 1 : end;
+            }
+
+            std::copy(argv + idx + 1, argv + argc, argv + idx);
+            --argc;
+            --idx;
+        }
+        return sizes;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    auto sizes = parse_sizes(argc, argv);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return EXIT_FAILURE;
+    }
+
+    register_benchmarks<int>("int", sizes);
+    register_benchmarks<double>("double", sizes);
+    register_benchmarks<std::string>("string", sizes, dist::as_long_string{});
+    register_benchmarks<large_value>("large_value", sizes, as_large_value{});
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+}
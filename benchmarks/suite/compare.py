@@ -0,0 +1,48 @@
+# -*- coding: utf-8 -*-
+
+# Copyright (c) 2022 Morwenn
+# SPDX-License-Identifier: MIT
+
+import argparse
+import json
+import sys
+
+
+def fetch_results(path):
+    with open(path) as fresults:
+        results = json.load(fresults)
+    return {
+        bench['name']: bench['real_time']
+        for bench in results['benchmarks']
+        if bench.get('run_type', 'iteration') == 'iteration' and 'error_occurred' not in bench
+    }
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description="Compare two JSON result files of the benchmark suite.")
+    parser.add_argument('baseline', help="JSON results of the reference commit")
+    parser.add_argument('contender', help="JSON results of the commit to check")
+    parser.add_argument('--threshold', type=float, default=5.0,
+                        help="only report differences of more than this percentage (default: 5)")
+    args = parser.parse_args()
+
+    baseline = fetch_results(args.baseline)
+    contender = fetch_results(args.contender)
+
+    regressions = 0
+    for name, base_time in baseline.items():
+        if name not in contender:
+            continue
+        diff = 100.0 * (contender[name] - base_time) / base_time
+        if abs(diff) <= args.threshold:
+            continue
+        if diff > 0:
+            regressions += 1
+        print(f"{name:<70} {base_time:>12.2f} {contender[name]:>12.2f} {diff:>+8.1f}%")
+
+    missing = sorted(baseline.keys() - contender.keys())
+    for name in missing:
+        print(f"{name:<70} missing from {args.contender}")
+
+    # Non-zero exit code when regressions were found, handy for scripts
+    sys.exit(1 if regressions > 0 else 0)
@@ -60,6 +60,8 @@ class CppSortConan(ConanFile):
         self.cpp_info.names["cmake_find_package_multi"] = "cpp-sort"
         if self.info.settings.compiler == "Visual Studio":
             self.cpp_info.cxxflags = ["/permissive-"]
+        if self.settings.os in ["Linux", "FreeBSD"]:
+            self.cpp_info.system_libs = ["pthread"]
 
     def package_id(self):
         self.info.clear()  # Header-only
@@ -9,11 +9,16 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <iterator>
 #include <locale>
 #include <type_traits>
 #include <utility>
 #include <cpp-sort/utility/static_const.h>
+#include <cpp-sort/utility/string_key_extractor.h>
+#include "../detail/ascii_simd.h"
+#include "../detail/iterator_traits.h"
 #include "../detail/type_traits.h"
 
 namespace cppsort
@@ -39,6 +44,99 @@ namespace cppsort
             }
         };
 
+        ////////////////////////////////////////////////////////////
+        // ASCII fast path
+        //
+        // When a ctype facet lowercases ASCII characters the same
+        // way the classic locale does, contiguous sequences of char
+        // can skip their common prefix of ASCII characters equal
+        // once lowercased without querying the facet, the rest of
+        // the sequences is compared with the facet
+
+        template<typename CharT>
+        auto has_ascii_case_folding(const std::ctype<CharT>&)
+            -> bool
+        {
+            return false;
+        }
+
+        inline auto has_ascii_case_folding(const std::ctype<char>& ct)
+            -> bool
+        {
+            char chars[128];
+            for (int idx = 0 ; idx < 128 ; ++idx) {
+                chars[idx] = static_cast<char>(idx);
+            }
+            ct.tolower(chars, chars + 128);
+            for (int idx = 0 ; idx < 128 ; ++idx) {
+                int expected = ('A' <= idx && idx <= 'Z') ? (idx | 0x20) : idx;
+                if (chars[idx] != static_cast<char>(expected)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Cheap check for the comparisons that retrieve the facet
+        // every time and can't afford to check all the characters
+
+        template<typename CharT>
+        auto is_classic_ctype(const std::ctype<CharT>&)
+            -> bool
+        {
+            return false;
+        }
+
+        inline auto is_classic_ctype(const std::ctype<char>& ct)
+            -> bool
+        {
+            static const auto& classic = std::use_facet<std::ctype<char>>(std::locale::classic());
+            return &ct == &classic;
+        }
+
+        template<typename InputIterator1, typename InputIterator2, typename CharT>
+        auto case_insensitive_compare(InputIterator1 first1, InputIterator1 last1,
+                                      InputIterator2 first2, InputIterator2 last2,
+                                      const std::ctype<CharT>& ct, bool, std::false_type)
+            -> bool
+        {
+            return std::lexicographical_compare(first1, last1, first2, last2,
+                                                char_less<CharT>(ct));
+        }
+
+        template<typename InputIterator1, typename InputIterator2, typename CharT>
+        auto case_insensitive_compare(InputIterator1 first1, InputIterator1 last1,
+                                      InputIterator2 first2, InputIterator2 last2,
+                                      const std::ctype<CharT>& ct, bool ascii_case_folding,
+                                      std::true_type)
+            -> bool
+        {
+            if (ascii_case_folding) {
+                auto size = (std::min)(last1 - first1, last2 - first2);
+                auto skipped = ascii_case_insensitive_prefix(as_char_pointer(first1, last1),
+                                                             as_char_pointer(first2, last2),
+                                                             static_cast<std::size_t>(size));
+                first1 += skipped;
+                first2 += skipped;
+            }
+            return std::lexicographical_compare(first1, last1, first2, last2,
+                                                char_less<CharT>(ct));
+        }
+
+        template<typename InputIterator1, typename InputIterator2, typename CharT>
+        auto case_insensitive_compare(InputIterator1 first1, InputIterator1 last1,
+                                      InputIterator2 first2, InputIterator2 last2,
+                                      const std::ctype<CharT>& ct, bool ascii_case_folding)
+            -> bool
+        {
+            using has_fast_path = conjunction<
+                is_contiguous_char_iterator<InputIterator1>,
+                is_contiguous_char_iterator<InputIterator2>
+            >;
+            return case_insensitive_compare(first1, last1, first2, last2,
+                                            ct, ascii_case_folding, has_fast_path{});
+        }
+
         template<typename T>
         auto case_insensitive_less(const T& lhs, const T& rhs, const std::locale& loc)
             -> bool
@@ -46,9 +144,9 @@ namespace cppsort
             using char_type = remove_cvref_t<decltype(*std::begin(lhs))>;
             const auto& ct = std::use_facet<std::ctype<char_type>>(loc);
 
-            return std::lexicographical_compare(std::begin(lhs), std::end(lhs),
-                                                std::begin(rhs), std::end(rhs),
-                                                char_less<char_type>(ct));
+            return case_insensitive_compare(std::begin(lhs), std::end(lhs),
+                                            std::begin(rhs), std::end(rhs),
+                                            ct, is_classic_ctype(ct));
         }
 
         template<typename T>
@@ -80,12 +178,18 @@ namespace cppsort
         constexpr bool can_be_refined_for
             = is_detected_v<can_be_refined_for_t, T>;
 
+        template<typename String, bool>
+        struct case_insensitive_key_extractor;
+
         struct case_insensitive_less_locale_fn
         {
             private:
 
                 std::locale loc;
 
+                template<typename String, bool>
+                friend struct case_insensitive_key_extractor;
+
             public:
 
                 explicit case_insensitive_less_locale_fn(const std::locale& loc):
@@ -174,12 +278,17 @@ namespace cppsort
 
                     std::locale loc;
                     const std::ctype<char_type>& ct;
+                    bool ascii_case_folding;
+
+                    template<typename String, bool>
+                    friend struct detail::case_insensitive_key_extractor;
 
                 public:
 
                     explicit refined_case_insensitive_less_locale_fn(const std::locale& loc):
                         loc(loc),
-                        ct(std::use_facet<std::ctype<char_type>>(loc))
+                        ct(std::use_facet<std::ctype<char_type>>(loc)),
+                        ascii_case_folding(has_ascii_case_folding(ct))
                     {}
 
                     template<typename U=T>
@@ -199,9 +308,9 @@ namespace cppsort
                             bool
                         >
                     {
-                        return std::lexicographical_compare(std::begin(lhs), std::end(lhs),
-                                                            std::begin(rhs), std::end(rhs),
-                                                            char_less<char_type>(ct));
+                        return case_insensitive_compare(std::begin(lhs), std::end(lhs),
+                                                        std::begin(rhs), std::end(rhs),
+                                                        ct, ascii_case_folding);
                     }
             };
 
@@ -214,12 +323,17 @@ namespace cppsort
 
                     std::locale loc;
                     const std::ctype<char_type>& ct;
+                    bool ascii_case_folding;
+
+                    template<typename String, bool>
+                    friend struct detail::case_insensitive_key_extractor;
 
                 public:
 
                     refined_case_insensitive_less_fn():
                         loc(),
-                        ct(std::use_facet<std::ctype<char_type>>(loc))
+                        ct(std::use_facet<std::ctype<char_type>>(loc)),
+                        ascii_case_folding(has_ascii_case_folding(ct))
                     {}
 
                     template<typename U=T>
@@ -255,9 +369,9 @@ namespace cppsort
                             bool
                         >
                     {
-                        return std::lexicographical_compare(std::begin(lhs), std::end(lhs),
-                                                            std::begin(rhs), std::end(rhs),
-                                                            char_less<char_type>(ct));
+                        return case_insensitive_compare(std::begin(lhs), std::end(lhs),
+                                                        std::begin(rhs), std::end(rhs),
+                                                        ct, ascii_case_folding);
                     }
 
                     auto operator()(const std::locale& loc) const
@@ -267,10 +381,93 @@ namespace cppsort
                     }
             };
         }
+
+        ////////////////////////////////////////////////////////////
+        // Keys for multikey string sorts, only standard strings are
+        // handled since case_insensitive_less could be customized
+        // for other types
+
+        template<
+            typename String,
+            bool = utility::detail::is_std_string<String>::value
+        >
+        struct case_insensitive_key_extractor {};
+
+        template<typename String>
+        struct case_insensitive_key_extractor<String, true>
+        {
+            private:
+
+                using char_type = typename String::value_type;
+
+                std::locale loc;
+                const std::ctype<char_type>& ct;
+
+            public:
+
+                using key_type = std::uintmax_t;
+
+                explicit case_insensitive_key_extractor(const case_insensitive_less_fn&):
+                    loc(),
+                    ct(std::use_facet<std::ctype<char_type>>(loc))
+                {}
+
+                template<typename Compare>
+                explicit case_insensitive_key_extractor(const Compare& compare):
+                    loc(compare.loc),
+                    ct(std::use_facet<std::ctype<char_type>>(loc))
+                {}
+
+                auto operator()(const String& str, std::size_t& pos) const
+                    -> key_type
+                {
+                    if (pos == str.size()) {
+                        return 0;
+                    }
+                    return utility::detail::ordered_char_key(ct.tolower(str[pos++])) + 1;
+                }
+        };
     }
 
     using case_insensitive_less_t = detail::case_insensitive_less_fn;
 
+    namespace utility
+    {
+        template<typename String>
+        struct string_key_extractor<case_insensitive_less_t, String>:
+            cppsort::detail::case_insensitive_key_extractor<String>
+        {
+            using cppsort::detail::case_insensitive_key_extractor<String>::case_insensitive_key_extractor;
+        };
+
+        template<typename String>
+        struct string_key_extractor<cppsort::detail::case_insensitive_less_locale_fn, String>:
+            cppsort::detail::case_insensitive_key_extractor<String>
+        {
+            using cppsort::detail::case_insensitive_key_extractor<String>::case_insensitive_key_extractor;
+        };
+
+        template<typename T, typename String>
+        struct string_key_extractor<
+            cppsort::detail::adl_barrier::refined_case_insensitive_less_fn<T>,
+            String
+        >:
+            cppsort::detail::case_insensitive_key_extractor<String>
+        {
+            using cppsort::detail::case_insensitive_key_extractor<String>::case_insensitive_key_extractor;
+        };
+
+        template<typename T, typename String>
+        struct string_key_extractor<
+            cppsort::detail::adl_barrier::refined_case_insensitive_less_locale_fn<T>,
+            String
+        >:
+            cppsort::detail::case_insensitive_key_extractor<String>
+        {
+            using cppsort::detail::case_insensitive_key_extractor<String>::case_insensitive_key_extractor;
+        };
+    }
+
     namespace
     {
         constexpr auto&& case_insensitive_less = utility::static_const<
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2019 Morwenn
+ * Copyright (c) 2016-2022 Morwenn
  * SPDX-License-Identifier: MIT
  */
 #ifndef CPPSORT_COMPARATORS_NATURAL_LESS_H_
@@ -8,15 +8,50 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <algorithm>
 #include <cctype>
+#include <cstddef>
+#include <cstdint>
 #include <iterator>
+#include <limits>
+#include <string>
+#include <type_traits>
 #include <utility>
 #include <cpp-sort/utility/static_const.h>
+#include <cpp-sort/utility/string_key_extractor.h>
+#include "../detail/ascii_simd.h"
+#include "../detail/iterator_traits.h"
+#include "../detail/type_traits.h"
+
+#if __cplusplus > 201402L && __has_include(<string_view>)
+#   include <string_view>
+#endif
 
 namespace cppsort
 {
     namespace detail
     {
+        ////////////////////////////////////////////////////////////
+        // Skip the equal characters that aren't digits at the start
+        // of both sequences, which can be done with SIMD instructions
+        // for contiguous sequences of char
+
+        template<typename ForwardIterator1, typename ForwardIterator2>
+        auto skip_equal_non_digits(ForwardIterator1&, ForwardIterator1,
+                                   ForwardIterator2&, ForwardIterator2)
+            -> void
+        {}
+
+        inline auto skip_equal_non_digits(const char*& begin1, const char* end1,
+                                          const char*& begin2, const char* end2)
+            -> void
+        {
+            auto size = (std::min)(end1 - begin1, end2 - begin2);
+            auto skipped = equal_non_digits_prefix(begin1, begin2, static_cast<std::size_t>(size));
+            begin1 += skipped;
+            begin2 += skipped;
+        }
+
         ////////////////////////////////////////////////////////////
         // Natural order for char sequences
 
@@ -25,7 +60,10 @@ namespace cppsort
                                ForwardIterator2 begin2, ForwardIterator2 end2)
             -> bool
         {
-            while (begin1 != end1 && begin2 != end2) {
+            while (true) {
+                skip_equal_non_digits(begin1, end1, begin2, end2);
+                if (begin1 == end1 || begin2 == end2) break;
+
                 auto last1 = begin1;
                 auto last2 = begin2;
                 do {
@@ -54,12 +92,9 @@ namespace cppsort
                     if (size1 != size2) {
                         return size1 < size2;
                     }
-                    if (size1 == 0) {
-                        return false;
-                    }
 
-                    // Sizes are equal and not 0
-                    while (begin1 != end1) {
+                    // Sizes are equal, compare the digits
+                    while (begin1 != last1) {
                         if (*begin1 != *begin2) {
                             return *begin1 < *begin2;
                         }
@@ -86,14 +121,106 @@ namespace cppsort
             return begin1 == end1 && begin2 != end2;
         }
 
+        template<typename ForwardIterator1, typename ForwardIterator2>
+        auto natural_less_dispatch(ForwardIterator1 begin1, ForwardIterator1 end1,
+                                   ForwardIterator2 begin2, ForwardIterator2 end2,
+                                   std::false_type /* contiguous char */)
+            -> bool
+        {
+            return natural_less_impl(begin1, end1, begin2, end2);
+        }
+
+        template<typename ContiguousIterator1, typename ContiguousIterator2>
+        auto natural_less_dispatch(ContiguousIterator1 begin1, ContiguousIterator1 end1,
+                                   ContiguousIterator2 begin2, ContiguousIterator2 end2,
+                                   std::true_type /* contiguous char */)
+            -> bool
+        {
+            const char* ptr1 = as_char_pointer(begin1, end1);
+            const char* ptr2 = as_char_pointer(begin2, end2);
+            return natural_less_impl(ptr1, ptr1 + (end1 - begin1),
+                                     ptr2, ptr2 + (end2 - begin2));
+        }
+
         template<typename T, typename U>
         auto natural_less(const T& lhs, const U& rhs)
             -> bool
         {
-            return natural_less_impl(std::begin(lhs), std::end(lhs),
-                                     std::begin(rhs), std::end(rhs));
+            using iterator1 = decltype(std::begin(lhs));
+            using iterator2 = decltype(std::begin(rhs));
+            return natural_less_dispatch(
+                std::begin(lhs), std::end(lhs),
+                std::begin(rhs), std::end(rhs),
+                conjunction<
+                    is_contiguous_char_iterator<iterator1>,
+                    is_contiguous_char_iterator<iterator2>
+                >{}
+            );
         }
 
+        ////////////////////////////////////////////////////////////
+        // Keys for multikey string sorts
+        //
+        // A digit run produces a single key made of the number of
+        // its significant digits and of the first of them, which is
+        // followed by one key per remaining digit; those keys sort
+        // between the keys of the characters that compare lower and
+        // higher than the digits to preserve the natural order
+
+        template<typename String>
+        struct natural_key_extractor
+        {
+            using key_type = std::uintmax_t;
+
+            natural_key_extractor() = default;
+
+            template<typename Compare>
+            explicit constexpr natural_key_extractor(const Compare&) noexcept {}
+
+            auto operator()(const String& str, std::size_t& pos) const
+                -> key_type
+            {
+                using char_type = typename String::value_type;
+                using utility::detail::ordered_char_key;
+
+                constexpr key_type zero_key = ordered_char_key(char_type('0')) + 1;
+                constexpr key_type high_keys_offset
+                    = key_type(1) << (std::numeric_limits<key_type>::digits - 4);
+
+                auto size = str.size();
+                if (pos == size) {
+                    return 0;
+                }
+
+                auto is_digit = [](char_type ch) {
+                    return char_type('0') <= ch && ch <= char_type('9');
+                };
+
+                if (not is_digit(str[pos])) {
+                    auto key = ordered_char_key(str[pos++]) + 1;
+                    return key < zero_key ? key : key + high_keys_offset;
+                }
+                if (pos > 0 && is_digit(str[pos - 1])) {
+                    // Remaining digits of a number
+                    return ordered_char_key(str[pos++]) + 1;
+                }
+
+                // Skip leading zeros and count significant digits
+                while (pos != size && str[pos] == char_type('0')) {
+                    ++pos;
+                }
+                auto last = pos;
+                while (last != size && is_digit(str[last])) {
+                    ++last;
+                }
+                if (last == pos) {
+                    return zero_key;
+                }
+                auto first_digit = static_cast<key_type>(str[pos++] - char_type('0'));
+                return zero_key + (last - pos) * 9 + first_digit;
+            }
+        };
+
         ////////////////////////////////////////////////////////////
         // Customization point
 
@@ -113,6 +240,39 @@ namespace cppsort
 
     using natural_less_t = detail::natural_less_fn;
 
+    namespace utility
+    {
+        template<typename CharT, typename Allocator>
+        struct string_key_extractor<
+            natural_less_t,
+            std::basic_string<CharT, std::char_traits<CharT>, Allocator>
+        >:
+            cppsort::detail::natural_key_extractor<
+                std::basic_string<CharT, std::char_traits<CharT>, Allocator>
+            >
+        {
+            using cppsort::detail::natural_key_extractor<
+                std::basic_string<CharT, std::char_traits<CharT>, Allocator>
+            >::natural_key_extractor;
+        };
+
+#if __cplusplus > 201402L && __has_include(<string_view>)
+        template<typename CharT>
+        struct string_key_extractor<
+            natural_less_t,
+            std::basic_string_view<CharT, std::char_traits<CharT>>
+        >:
+            cppsort::detail::natural_key_extractor<
+                std::basic_string_view<CharT, std::char_traits<CharT>>
+            >
+        {
+            using cppsort::detail::natural_key_extractor<
+                std::basic_string_view<CharT, std::char_traits<CharT>>
+            >::natural_key_extractor;
+        };
+#endif
+    }
+
     namespace
     {
         constexpr auto&& natural_less = utility::static_const<
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_ASCII_SIMD_H_
+#define CPPSORT_DETAIL_ASCII_SIMD_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include "bitops.h"
+#include "config.h"
+#include "iterator_traits.h"
+#include "type_traits.h"
+
+#if CPPSORT_SSE2_AVAILABLE || CPPSORT_AVX2_AVAILABLE
+#   include <immintrin.h>
+#endif
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // ASCII fast paths for the string comparators
+    //
+    // The following functions compute the length of the common
+    // prefix of two sequences of char that a comparator can skip
+    // without examining the characters one by one: they stop at
+    // the first position that needs the general algorithm, which
+    // is either a difference between the sequences or a character
+    // that the fast path doesn't handle. The prefix is searched
+    // 32 bytes at a time with AVX2 and 16 bytes at a time with
+    // SSE2, the remaining characters are handled by scalar code.
+
+    template<typename Iterator>
+    struct is_contiguous_char_iterator:
+        conjunction<
+            is_contiguous_iterator<Iterator>,
+            std::is_same<value_type_t<Iterator>, char>
+        >
+    {};
+
+    template<typename Iterator>
+    auto as_char_pointer(Iterator first, Iterator last)
+        -> const char*
+    {
+        // Empty collections might not be dereferenceable
+        return first == last ? nullptr : std::addressof(*first);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Equal characters once ASCII letters are lowercased, stops
+    // at the first non-ASCII character
+
+    inline auto ascii_case_insensitive_prefix(const char* lhs, const char* rhs,
+                                              std::size_t size)
+        -> std::size_t
+    {
+        std::size_t pos = 0;
+
+#if CPPSORT_AVX2_AVAILABLE
+        {
+            const __m256i before_upper = _mm256_set1_epi8('A' - 1);
+            const __m256i after_upper = _mm256_set1_epi8('Z' + 1);
+            const __m256i case_bit = _mm256_set1_epi8(0x20);
+            auto to_lower = [&](__m256i chars) {
+                // Non-ASCII bytes are negative and never folded
+                __m256i is_upper = _mm256_and_si256(_mm256_cmpgt_epi8(chars, before_upper),
+                                                    _mm256_cmpgt_epi8(after_upper, chars));
+                return _mm256_or_si256(chars, _mm256_and_si256(is_upper, case_bit));
+            };
+
+            for (; pos + 32 <= size ; pos += 32) {
+                __m256i lhs_chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + pos));
+                __m256i rhs_chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + pos));
+                __m256i equal = _mm256_cmpeq_epi8(to_lower(lhs_chars), to_lower(rhs_chars));
+                auto stop = ~static_cast<unsigned>(_mm256_movemask_epi8(equal))
+                          | static_cast<unsigned>(_mm256_movemask_epi8(_mm256_or_si256(lhs_chars, rhs_chars)));
+                if (stop != 0) {
+                    return pos + static_cast<std::size_t>(countr_zero(stop));
+                }
+            }
+        }
+#endif
+
+#if CPPSORT_SSE2_AVAILABLE
+        {
+            const __m128i before_upper = _mm_set1_epi8('A' - 1);
+            const __m128i after_upper = _mm_set1_epi8('Z' + 1);
+            const __m128i case_bit = _mm_set1_epi8(0x20);
+            auto to_lower = [&](__m128i chars) {
+                __m128i is_upper = _mm_and_si128(_mm_cmpgt_epi8(chars, before_upper),
+                                                 _mm_cmpgt_epi8(after_upper, chars));
+                return _mm_or_si128(chars, _mm_and_si128(is_upper, case_bit));
+            };
+
+            for (; pos + 16 <= size ; pos += 16) {
+                __m128i lhs_chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + pos));
+                __m128i rhs_chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + pos));
+                __m128i equal = _mm_cmpeq_epi8(to_lower(lhs_chars), to_lower(rhs_chars));
+                auto stop = (~static_cast<unsigned>(_mm_movemask_epi8(equal)) & 0xFFFFu)
+                          | static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(lhs_chars, rhs_chars)));
+                if (stop != 0) {
+                    return pos + static_cast<std::size_t>(countr_zero(stop));
+                }
+            }
+        }
+#endif
+
+        auto to_lower = [](unsigned char ch) {
+            return ('A' <= ch && ch <= 'Z') ? (ch | 0x20u) : ch;
+        };
+        for (; pos < size ; ++pos) {
+            auto lhs_char = static_cast<unsigned char>(lhs[pos]);
+            auto rhs_char = static_cast<unsigned char>(rhs[pos]);
+            if (((lhs_char | rhs_char) & 0x80u) || to_lower(lhs_char) != to_lower(rhs_char)) {
+                break;
+            }
+        }
+        return pos;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Equal characters that aren't decimal digits
+
+    inline auto equal_non_digits_prefix(const char* lhs, const char* rhs,
+                                        std::size_t size)
+        -> std::size_t
+    {
+        std::size_t pos = 0;
+
+#if CPPSORT_AVX2_AVAILABLE
+        {
+            const __m256i before_digits = _mm256_set1_epi8('0' - 1);
+            const __m256i after_digits = _mm256_set1_epi8('9' + 1);
+            for (; pos + 32 <= size ; pos += 32) {
+                __m256i lhs_chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + pos));
+                __m256i rhs_chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + pos));
+                __m256i is_digit = _mm256_and_si256(_mm256_cmpgt_epi8(lhs_chars, before_digits),
+                                                    _mm256_cmpgt_epi8(after_digits, lhs_chars));
+                auto stop = ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lhs_chars, rhs_chars)))
+                          | static_cast<unsigned>(_mm256_movemask_epi8(is_digit));
+                if (stop != 0) {
+                    return pos + static_cast<std::size_t>(countr_zero(stop));
+                }
+            }
+        }
+#endif
+
+#if CPPSORT_SSE2_AVAILABLE
+        {
+            const __m128i before_digits = _mm_set1_epi8('0' - 1);
+            const __m128i after_digits = _mm_set1_epi8('9' + 1);
+            for (; pos + 16 <= size ; pos += 16) {
+                __m128i lhs_chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + pos));
+                __m128i rhs_chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + pos));
+                __m128i is_digit = _mm_and_si128(_mm_cmpgt_epi8(lhs_chars, before_digits),
+                                                 _mm_cmpgt_epi8(after_digits, lhs_chars));
+                auto stop = (~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(lhs_chars, rhs_chars))) & 0xFFFFu)
+                          | static_cast<unsigned>(_mm_movemask_epi8(is_digit));
+                if (stop != 0) {
+                    return pos + static_cast<std::size_t>(countr_zero(stop));
+                }
+            }
+        }
+#endif
+
+        for (; pos < size ; ++pos) {
+            if (lhs[pos] != rhs[pos] || ('0' <= lhs[pos] && lhs[pos] <= '9')) {
+                break;
+            }
+        }
+        return pos;
+    }
+}}
+
+#endif // CPPSORT_DETAIL_ASCII_SIMD_H_
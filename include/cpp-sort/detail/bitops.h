@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2021 Morwenn
+ * Copyright (c) 2015-2022 Morwenn
  * SPDX-License-Identifier: MIT
  */
 #ifndef CPPSORT_DETAIL_BITOPS_H_
@@ -100,6 +100,28 @@ namespace detail
         return log;
     }
 
+    // Returns the number of trailing zero bits, assumes n > 0
+
+#if defined(__GNUC__) || defined(__clang__)
+    constexpr auto countr_zero(unsigned int n)
+        -> int
+    {
+        return __builtin_ctz(n);
+    }
+#endif
+
+    template<typename Unsigned>
+    constexpr auto countr_zero(Unsigned n)
+        -> int
+    {
+        int res = 0;
+        while ((n & 1u) == 0) {
+            n >>= 1;
+            ++res;
+        }
+        return res;
+    }
+
     // Halves a positive number, using unsigned division if possible
 
     template<typename Integer>
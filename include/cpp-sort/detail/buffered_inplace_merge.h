@@ -26,6 +26,7 @@
 #include "config.h"
 #include "iterator_traits.h"
 #include "memory.h"
+#include "merge_kernel.h"
 #include "move.h"
 #include "type_traits.h"
 
@@ -49,6 +50,16 @@ namespace detail
         auto&& comp = utility::as_function(compare);
         auto&& proj = utility::as_function(projection);
 
+        using use_kernel = use_merge_kernel<
+            InputIterator1, InputIterator2, OutputIterator,
+            Compare, Projection, Projection
+        >;
+        if (use_kernel::value && first1 != last1 && first2 != last2) {
+            merge_kernel_forward(first1, last1, first2, last2, result,
+                                 std::move(compare), projection, projection, use_kernel{});
+            return;
+        }
+
         for (; min_len != 0 ; --min_len) {
             CPPSORT_ASSUME(first1 != last1);
             CPPSORT_ASSUME(first2 != last2);
@@ -118,6 +129,15 @@ namespace detail
                                std::move(compare), std::move(projection));
         } else {
             auto ptr = uninitialized_move(middle, last, buff, d);
+            using use_kernel = use_merge_kernel<
+                BidirectionalIterator, rvalue_type*, BidirectionalIterator,
+                Compare, Projection, Projection
+            >;
+            if (use_kernel::value && len1 != 0 && len2 != 0) {
+                merge_kernel_backward(first, middle, buff, ptr, last,
+                                      std::move(compare), projection, projection, use_kernel{});
+                return;
+            }
             using rbi = std::reverse_iterator<BidirectionalIterator>;
             using rv = std::reverse_iterator<rvalue_type*>;
             half_inplace_merge(rv(ptr), rv(buff),
@@ -58,6 +58,32 @@
 #   define CPPSORT_STD_IDENTITY_AVAILABLE 0
 #endif
 
+////////////////////////////////////////////////////////////
+// SIMD instruction sets
+
+// Some algorithms have dedicated code paths for specific x86
+// instruction sets, those are selected at compile time depending
+// on the instruction sets the compiler is allowed to target, and
+// can be disabled altogether by defining CPPSORT_DISABLE_SIMD
+
+#if !defined(CPPSORT_DISABLE_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#   define CPPSORT_SSE2_AVAILABLE 1
+#else
+#   define CPPSORT_SSE2_AVAILABLE 0
+#endif
+
+#if !defined(CPPSORT_DISABLE_SIMD) && defined(__AVX2__)
+#   define CPPSORT_AVX2_AVAILABLE 1
+#else
+#   define CPPSORT_AVX2_AVAILABLE 0
+#endif
+
+#if !defined(CPPSORT_DISABLE_SIMD) && defined(__AVX512F__)
+#   define CPPSORT_AVX512F_AVAILABLE 1
+#else
+#   define CPPSORT_AVX512F_AVAILABLE 0
+#endif
+
 ////////////////////////////////////////////////////////////
 // General: assertions
 
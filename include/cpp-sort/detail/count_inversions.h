@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2021 Morwenn
+ * Copyright (c) 2016-2022 Morwenn
  * SPDX-License-Identifier: MIT
  */
 #ifndef CPPSORT_DETAIL_COUNT_INVERSIONS_H_
@@ -66,6 +66,34 @@ namespace detail
         return inversions;
     }
 
+    // Number of moves performed by an insertion sort
+    template<typename ResultType, typename RandomAccessIterator,
+             typename Compare, typename Projection>
+    auto count_inversions_insertion(RandomAccessIterator first, RandomAccessIterator last,
+                                    Compare compare, Projection projection)
+        -> ResultType
+    {
+        using utility::iter_move;
+        auto&& comp = utility::as_function(compare);
+        auto&& proj = utility::as_function(projection);
+
+        ResultType inversions = 0;
+        for (auto cur = first + 1 ; cur != last ; ++cur) {
+            auto sift = cur;
+            auto sift_1 = cur - 1;
+            if (comp(proj(*sift), proj(*sift_1))) {
+                auto tmp = iter_move(sift);
+                auto&& tmp_proj = proj(tmp);
+                do {
+                    *sift = iter_move(sift_1);
+                    ++inversions;
+                } while (--sift != first && comp(tmp_proj, proj(*--sift_1)));
+                *sift = std::move(tmp);
+            }
+        }
+        return inversions;
+    }
+
     template<
         typename ResultType,
         typename RandomAccessIterator1,
@@ -81,6 +109,10 @@ namespace detail
         if (size < 2) {
             return 0;
         }
+        if (size <= 16) {
+            return count_inversions_insertion<ResultType>(std::move(first), std::move(last),
+                                                          std::move(compare), std::move(projection));
+        }
 
         ResultType inversions = 0;
         auto middle = first + size / 2;
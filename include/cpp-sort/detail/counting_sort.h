@@ -9,16 +9,128 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <algorithm>
+#include <cstddef>
 #include <functional>
 #include <iterator>
+#include <type_traits>
 #include "immovable_vector.h"
 #include "iterator_traits.h"
 #include "minmax_element_and_is_sorted.h"
+#include "ska_sort.h"
+#include "type_traits.h"
 
 namespace cppsort
 {
 namespace detail
 {
+    ////////////////////////////////////////////////////////////
+    // Sparse ranges
+    //
+    // When a few values are far apart from the others, the range
+    // of values can be much bigger than the collection, and so is
+    // the memory needed to count them. In such a case the values
+    // are copied to a buffer of the size of the collection where
+    // they are sorted with ska_sort - a radix sort which does not
+    // depend on the range of values -, and written back from there.
+
+    namespace counting_sort_detail
+    {
+        // The counts are used when there are at most that many
+        // possible values per element of the collection
+        constexpr std::size_t max_values_per_element = 4;
+
+        // ska_sort orders char and wchar_t like the unsigned integers
+        // of the same size, which is not the order of std::less<> when
+        // they are signed: the sparse path sorts them through this
+        // projection to an integer type with the same order instead
+        struct as_ordered_integer
+        {
+            template<typename Integer>
+            auto operator()(Integer value) const
+                -> Integer
+            {
+                return value;
+            }
+
+            auto operator()(char value) const
+                -> conditional_t<std::is_signed<char>::value, signed char, unsigned char>
+            {
+                return static_cast<conditional_t<std::is_signed<char>::value, signed char, unsigned char>>(value);
+            }
+
+            auto operator()(wchar_t value) const
+                -> conditional_t<
+                    std::is_signed<wchar_t>::value,
+                    std::make_signed_t<wchar_t>,
+                    std::make_unsigned_t<wchar_t>
+                >
+            {
+                return static_cast<conditional_t<
+                    std::is_signed<wchar_t>::value,
+                    std::make_signed_t<wchar_t>,
+                    std::make_unsigned_t<wchar_t>
+                >>(value);
+            }
+        };
+
+        // Difference between max and min, computed without overflow
+        // in a type wider than Integer when there is one
+        template<typename Integer>
+        auto value_range(Integer min, Integer max, std::true_type /* narrow */)
+            -> unsigned long long
+        {
+            long long wide_min = min;
+            long long wide_max = max;
+            return static_cast<unsigned long long>(wide_max - wide_min);
+        }
+
+        template<typename Integer>
+        auto value_range(Integer min, Integer max, std::false_type /* narrow */)
+            -> decltype(to_unsigned_or_bool(max))
+        {
+            // Mapping the values of types at least as wide as long long
+            // to unsigned integers preserves their order
+            return to_unsigned_or_bool(max) - to_unsigned_or_bool(min);
+        }
+
+        template<typename Integer>
+        auto is_sparse_range(Integer min, Integer max, std::size_t size)
+            -> bool
+        {
+            auto range = value_range(min, max, std::integral_constant<bool,
+                (sizeof(Integer) < sizeof(long long))
+            >{});
+            using range_type = decltype(range);
+
+            std::size_t max_range = size * max_values_per_element;
+            if (sizeof(range_type) > sizeof(std::size_t)) {
+                return range >= static_cast<range_type>(max_range);
+            }
+            return static_cast<std::size_t>(range) >= max_range;
+        }
+
+        template<typename ForwardIterator>
+        auto sparse_counting_sort(ForwardIterator first, ForwardIterator last,
+                                  difference_type_t<ForwardIterator> size, bool reverse)
+            -> void
+        {
+            immovable_vector<value_type_t<ForwardIterator>> values(size);
+            for (auto it = first; it != last; ++it) {
+                values.emplace_back(*it);
+            }
+
+            ska_sort(values.begin(), values.end(), as_ordered_integer{});
+            if (reverse) {
+                std::reverse_copy(values.begin(), values.end(), first);
+            } else {
+                std::copy(values.begin(), values.end(), first);
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Counting sort
+
     template<typename ForwardIterator>
     auto counting_sort(ForwardIterator first, ForwardIterator last)
         -> void
@@ -30,12 +142,15 @@ namespace detail
 
         auto min = *info.min;
         auto max = *info.max;
+        auto size = std::distance(first, last);
+        if (counting_sort_detail::is_sparse_range(min, max, static_cast<std::size_t>(size))) {
+            counting_sort_detail::sparse_counting_sort(first, last, size, false);
+            return;
+        }
         difference_type value_range = max - min + 1;
 
         immovable_vector<difference_type> counts(value_range);
-        for (difference_type n = 0; n < value_range; ++n) {
-            counts.emplace_back(0);
-        }
+        counts.fill_back(value_range, 0);
 
         for (auto it = first; it != last; ++it) {
             ++counts[*it - min];
@@ -57,12 +172,15 @@ namespace detail
 
         auto min = *info.max;
         auto max = *info.min;
+        auto size = std::distance(first, last);
+        if (counting_sort_detail::is_sparse_range(min, max, static_cast<std::size_t>(size))) {
+            counting_sort_detail::sparse_counting_sort(first, last, size, true);
+            return;
+        }
         difference_type value_range = max - min + 1;
 
         immovable_vector<difference_type> counts(value_range);
-        for (difference_type n = 0; n < value_range; ++n) {
-            counts.emplace_back(0);
-        }
+        counts.fill_back(value_range, 0);
 
         for (auto it = first; it != last; ++it) {
             ++counts[*it - min];
@@ -9,11 +9,13 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <cstddef>
+#include <memory>
 #include <new>
 #include <utility>
 #include <cpp-sort/utility/iter_move.h>
 #include "config.h"
 #include "memory.h"
+#include "scratch_memory.h"
 
 namespace cppsort
 {
@@ -48,7 +50,7 @@ namespace detail
             explicit immovable_vector(std::ptrdiff_t n):
                 capacity_(n),
                 memory_(
-                    static_cast<T*>(::operator new(n * sizeof(T)))
+                    static_cast<T*>(allocate_scratch(n * sizeof(T)))
                 ),
                 end_(memory_)
             {}
@@ -62,11 +64,7 @@ namespace detail
                 detail::destroy(memory_, end_);
 
                 // Free the allocated memory
-#ifdef __cpp_sized_deallocation
-                ::operator delete(memory_, capacity_ * sizeof(T));
-#else
-                ::operator delete(memory_);
-#endif
+                deallocate_scratch(memory_, capacity_ * sizeof(T));
             }
 
             ////////////////////////////////////////////////////////////
@@ -130,6 +128,13 @@ namespace detail
                 return std::exchange(end_, end_ + 1);
             }
 
+            auto fill_back(std::ptrdiff_t count, const T& value)
+                -> void
+            {
+                CPPSORT_ASSERT(end_ - memory_ + count <= capacity_);
+                end_ = std::uninitialized_fill_n(end_, count, value);
+            }
+
             template<typename Iterator>
             auto insert_back(Iterator first, Iterator last)
                 -> void
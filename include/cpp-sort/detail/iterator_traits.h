@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2018 Morwenn
+ * Copyright (c) 2016-2022 Morwenn
  * SPDX-License-Identifier: MIT
  */
 #ifndef CPPSORT_DETAIL_ITERATOR_TRAITS_H_
@@ -9,7 +9,9 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <iterator>
+#include <string>
 #include <utility>
+#include <vector>
 #include <cpp-sort/utility/iter_move.h>
 #include "type_traits.h"
 
@@ -49,6 +51,32 @@ namespace detail
     // Handy addition from time to time
     template<typename Iterator, typename Projection>
     using projected_t = remove_cvref_t<invoke_result_t<Projection, decltype(*std::declval<Iterator&>())>>;
+
+    //
+    // Conservative check for iterators whose elements are known
+    // to be laid out contiguously in memory: we can't detect it
+    // reliably before C++20, so we only recognize pointers and
+    // the iterators of std::vector and std::string in that case
+    //
+
+    template<typename Iterator>
+    struct is_contiguous_iterator:
+        disjunction<
+            std::is_pointer<Iterator>,
+            std::is_same<Iterator, std::string::iterator>,
+            std::is_same<Iterator, std::string::const_iterator>,
+#ifdef __cpp_lib_concepts
+            std::bool_constant<std::contiguous_iterator<Iterator>>,
+#endif
+            conjunction<
+                negation<std::is_same<value_type_t<Iterator>, bool>>,
+                disjunction<
+                    std::is_same<Iterator, typename std::vector<value_type_t<Iterator>>::iterator>,
+                    std::is_same<Iterator, typename std::vector<value_type_t<Iterator>>::const_iterator>
+                >
+            >
+        >
+    {};
 }}
 
 #endif // CPPSORT_DETAIL_ITERATOR_TRAITS_H_
@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_LSD_RADIX_SORT_H_
+#define CPPSORT_DETAIL_LSD_RADIX_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/buffer.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/iter_move.h>
+#include "insertion_sort.h"
+#include "iterator_traits.h"
+#include "memory.h"
+#include "move.h"
+#include "ska_sort.h"
+#include "type_traits.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // LSD radix sort
+    //
+    // Least significant digit radix sort working on the bytes of
+    // the unsigned integer key computed by ska_sort's SubKey for
+    // fixed-width types. The histograms of every byte are computed
+    // in a single pass over the collection, then every byte that
+    // is not shared by all the keys is handled by a stable pass
+    // which moves the elements back and forth between the
+    // collection and a buffer as big as the collection.
+    //
+    // Every pass reads and writes the whole collection, so the
+    // algorithm loses to the in-place ska_sort when the keys
+    // differ on too many bytes, which is estimated from a small
+    // sample of the keys before doing anything else.
+
+    namespace lsd_radix_sort_detail
+    {
+        // Below this size, a simple insertion sort is used instead
+        constexpr std::ptrdiff_t insertion_sort_threshold = 64;
+
+        // Number of keys sampled to estimate the number of passes,
+        // and maximum number of passes worth doing
+        constexpr std::ptrdiff_t sample_size = 64;
+        constexpr std::size_t max_passes = 5;
+
+        // Buffer provided by BufferProvider; the elements of the
+        // default dynamic_buffer are value-initialized, which would
+        // cost as much as a pass over the collection for elements
+        // that are always written before being read, so it is
+        // replaced with a default-initialized buffer of the same size,
+        // which is empty when the memory can't be allocated
+        template<typename BufferProvider, typename T>
+        struct buffer_for
+        {
+            using type = typename BufferProvider::template buffer<T>;
+        };
+
+        template<typename T>
+        class uninitialized_buffer
+        {
+            public:
+
+                explicit uninitialized_buffer(std::size_t size):
+                    _size(0),
+                    _memory(
+                        static_cast<T*>(::operator new(size * sizeof(T), std::nothrow)),
+                        operator_deleter(size * sizeof(T))
+                    )
+                {
+                    if (_memory == nullptr) {
+                        return;
+                    }
+                    try {
+                        for (; _size < size ; ++_size) {
+                            ::new(_memory.get() + _size) T;
+                        }
+                    } catch (...) {
+                        detail::destroy_n(_memory.get(), _size);
+                        throw;
+                    }
+                }
+
+                uninitialized_buffer(const uninitialized_buffer&) = delete;
+                uninitialized_buffer& operator=(const uninitialized_buffer&) = delete;
+
+                ~uninitialized_buffer()
+                {
+                    detail::destroy_n(_memory.get(), _size);
+                }
+
+                auto size() const
+                    -> std::size_t
+                {
+                    return _size;
+                }
+
+                auto begin()
+                    -> T*
+                {
+                    return _memory.get();
+                }
+
+            private:
+
+                std::size_t _size;
+                std::unique_ptr<T, operator_deleter> _memory;
+        };
+
+        template<typename T>
+        struct buffer_for<utility::dynamic_buffer<utility::identity>, T>
+        {
+            using type = uninitialized_buffer<T>;
+        };
+
+        template<typename SubKeyType>
+        auto get_byte(SubKeyType key, std::size_t byte)
+            -> std::size_t
+        {
+            return static_cast<std::size_t>((key >> (byte * 8)) & 0xff);
+        }
+
+        // Moves the elements of [first, last) to result in the order
+        // of the given byte of their keys, offsets is turned from a
+        // histogram into the end offsets of the buckets
+        template<typename SubKey, typename InputIterator, typename OutputIterator, typename Projection>
+        auto scatter(InputIterator first, InputIterator last, OutputIterator result,
+                     std::array<std::size_t, 256>& offsets, std::size_t byte,
+                     Projection projection)
+            -> void
+        {
+            using utility::iter_move;
+            auto&& proj = utility::as_function(projection);
+
+            std::size_t total = 0;
+            for (auto& offset: offsets) {
+                std::size_t count = offset;
+                offset = total;
+                total += count;
+            }
+
+            for (auto it = first ; it != last ; ++it) {
+                auto key = SubKey::sub_key(proj(*it), nullptr);
+                result[offsets[get_byte(key, byte)]++] = iter_move(it);
+            }
+        }
+    }
+
+    template<typename BufferProvider, typename RandomAccessIterator, typename Projection>
+    auto lsd_radix_sort(RandomAccessIterator first, RandomAccessIterator last,
+                        Projection projection)
+        -> void
+    {
+        using namespace lsd_radix_sort_detail;
+        using sub_key = SubKey<projected_t<RandomAccessIterator, Projection>>;
+        using sub_key_type = typename sub_key::sub_key_type;
+        constexpr std::size_t num_bytes = sizeof(sub_key_type);
+        auto&& proj = utility::as_function(projection);
+
+        auto size = last - first;
+        if (size < insertion_sort_threshold) {
+            // Keys are compared directly, which keeps the sort stable
+            insertion_sort(
+                std::move(first), std::move(last),
+                [](const auto& lhs, const auto& rhs) {
+                    return sub_key::sub_key(lhs, nullptr) < sub_key::sub_key(rhs, nullptr);
+                },
+                std::move(projection)
+            );
+            return;
+        }
+
+        // Estimate the number of passes from the bytes that differ
+        // between a few evenly spaced keys and the first one
+        auto first_key = sub_key::sub_key(proj(*first), nullptr);
+        sub_key_type diff_mask = 0;
+        for (auto step = size / sample_size, idx = step ; idx < size ; idx += step) {
+            diff_mask |= sub_key::sub_key(proj(first[idx]), nullptr) ^ first_key;
+        }
+        std::size_t nb_passes = 0;
+        for (std::size_t byte = 0 ; byte < num_bytes ; ++byte) {
+            nb_passes += get_byte(diff_mask, byte) != 0;
+        }
+        if (nb_passes > max_passes) {
+            ska_sort(std::move(first), std::move(last), std::move(projection));
+            return;
+        }
+
+        // Allocate the buffer, fall back to the in-place ska_sort if the
+        // buffer provider doesn't give us enough memory
+        using buffer_type = typename buffer_for<BufferProvider, rvalue_type_t<RandomAccessIterator>>::type;
+        buffer_type buffer(static_cast<std::size_t>(size));
+        if (buffer.size() < static_cast<std::size_t>(size)) {
+            ska_sort(std::move(first), std::move(last), std::move(projection));
+            return;
+        }
+
+        // Compute the histograms of all bytes in a single pass
+        std::array<std::array<std::size_t, 256>, num_bytes> histograms = {};
+        for (auto it = first ; it != last ; ++it) {
+            auto key = sub_key::sub_key(proj(*it), nullptr);
+            for (std::size_t byte = 0 ; byte < num_bytes ; ++byte) {
+                ++histograms[byte][get_byte(key, byte)];
+            }
+        }
+
+        // Handle every byte that isn't the same for all keys, moving the
+        // elements back and forth between the collection and the buffer
+        bool in_buffer = false;
+        for (std::size_t byte = 0 ; byte < num_bytes ; ++byte) {
+            auto& histogram = histograms[byte];
+            if (histogram[get_byte(first_key, byte)] == static_cast<std::size_t>(size)) {
+                continue;
+            }
+
+            if (in_buffer) {
+                scatter<sub_key>(buffer.begin(), buffer.begin() + size, first,
+                                 histogram, byte, projection);
+            } else {
+                scatter<sub_key>(first, last, buffer.begin(),
+                                 histogram, byte, projection);
+            }
+            in_buffer = not in_buffer;
+        }
+
+        if (in_buffer) {
+            detail::move(buffer.begin(), buffer.begin() + size, first);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Types handled by lsd_radix_sort: the ones for which ska_sort
+    // only computes a single fixed-width unsigned integer key
+
+    template<typename T>
+    struct is_lsd_radix_sortable:
+        conjunction<
+            is_integral<T>,
+            negation<std::is_same<T, bool>>
+        >
+    {};
+
+    template<typename T>
+    struct is_lsd_radix_sortable<T*>:
+        std::true_type
+    {};
+
+    template<>
+    struct is_lsd_radix_sortable<float>:
+        is_ska_sortable<float>
+    {};
+
+    template<>
+    struct is_lsd_radix_sortable<double>:
+        is_ska_sortable<double>
+    {};
+
+    template<typename T>
+    constexpr bool is_lsd_radix_sortable_v = is_lsd_radix_sortable<T>::value;
+}}
+
+#endif // CPPSORT_DETAIL_LSD_RADIX_SORT_H_
@@ -0,0 +1,1226 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_MERGE_KERNEL_H_
+#define CPPSORT_DETAIL_MERGE_KERNEL_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/utility/as_function.h>
+#include "config.h"
+#include "iterator_traits.h"
+#include "simd_traits.h"
+#include "type_traits.h"
+
+#if CPPSORT_AVX2_AVAILABLE || CPPSORT_AVX512F_AVAILABLE
+#   include <immintrin.h>
+#endif
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Merge kernel
+    //
+    // Specialized merge of two sorted runs of trivially copyable
+    // values, used in place of the element-by-element merge loops
+    // of the merge-based algorithms when they operate on contiguous
+    // memory:
+    // - The kernel probes how the runs interleave, then merges the
+    //   values without branches a block of elements at a time when
+    //   the runs interleave unpredictably, and with a branchy merge
+    //   loop otherwise: that loop gallops through the long stretches
+    //   of values from the same run with an exponential search and
+    //   moves the elements found this way with a single memmove.
+    //   Once one of the runs has less than a block left, its
+    //   elements are inserted one by one in the other run with the
+    //   same galloping search.
+    // - When AVX2 is available, runs of 32-bit integers compared
+    //   with std::less<> or std::greater<> without any projection
+    //   are merged 8 elements at a time with a bitonic merge network,
+    //   and so are runs of 64-bit integers when AVX-512 is available.
+    //   Equivalent integers can't be distinguished, so the merge
+    //   network doesn't need to preserve the order of the runs.
+    //
+    // Every kernel can run in both directions: the forward merge
+    // writes the merged values from the beginning of the output,
+    // and the backward merge from its end. Both of them support
+    // the blind merges where the output ends (or begins) where
+    // the run that wasn't moved to a buffer is located, in which
+    // case the values left in that run are not moved once the
+    // other run is exhausted.
+
+    namespace merge_kernel_detail
+    {
+        // Number of elements of a block
+        constexpr std::ptrdiff_t block_size = 8;
+
+        // Number of elements merged by the branchy merge before it
+        // checks whether it should gallop
+        constexpr std::ptrdiff_t chunk_size = 16;
+
+        // Number of values a run has to provide in a row before the
+        // probe stops and hands over to the branchy merge
+        constexpr std::ptrdiff_t probe_max_stretch = 7;
+
+        // Number of stretches of values taken from the same run that
+        // the probe records before picking the next merge strategy
+        constexpr std::ptrdiff_t stretches_window = 8;
+
+        // Number of blocks after which the branchless merge stops so
+        // that the kernel probes the runs again
+        constexpr int branchless_window = 32;
+
+        // Number of chunks that the branchy merge handles before it
+        // stops so that the kernel probes the runs again
+        constexpr std::ptrdiff_t branchy_budget = 16;
+
+        // Same as above for the kernels that use merge networks, which
+        // beat the branchy merge by more when the runs are interleaved
+        constexpr std::ptrdiff_t simd_branchy_budget = 4;
+
+        template<typename T>
+        auto move_values(const T* first, const T* last, T* result)
+            -> T*
+        {
+            auto size = last - first;
+            if (result != first) {
+                std::memmove(result, first, size * sizeof(T));
+            }
+            return result + size;
+        }
+
+        template<typename T>
+        auto move_values_backward(const T* first, const T* last, T* result)
+            -> T*
+        {
+            auto size = last - first;
+            if (result != last) {
+                std::memmove(result - size, first, size * sizeof(T));
+            }
+            return result - size;
+        }
+
+        // Finds the end of the prefix of [first, last) for which pred
+        // is true, knowing that it is true for the first element
+        template<typename T, typename Predicate>
+        auto gallop_forward(const T* first, const T* last, Predicate pred)
+            -> const T*
+        {
+            std::ptrdiff_t size = last - first;
+            std::ptrdiff_t lo = 0;
+            std::ptrdiff_t hi = 1;
+            while (hi < size && pred(first[hi])) {
+                lo = hi;
+                hi = 2 * hi + 1;
+            }
+            hi = (std::min)(hi, size);
+            return std::partition_point(first + lo + 1, first + hi, pred);
+        }
+
+        // Finds the beginning of the suffix of [first, last) for which
+        // pred is true, knowing that it is true for the last element
+        template<typename T, typename Predicate>
+        auto gallop_backward(const T* first, const T* last, Predicate pred)
+            -> const T*
+        {
+            std::ptrdiff_t size = last - first;
+            std::ptrdiff_t lo = 0;
+            std::ptrdiff_t hi = 1;
+            while (hi < size && pred(last[-hi - 1])) {
+                lo = hi;
+                hi = 2 * hi + 1;
+            }
+            hi = (std::min)(hi, size);
+            return std::partition_point(last - hi, last - lo - 1, [&](const T& value) {
+                return not pred(value);
+            });
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Merge strategies
+        //
+        // The branchless merge avoids the mispredictions of the usual
+        // merge loop when the runs interleave unpredictably, but its
+        // loop-carried dependency makes it several times slower than
+        // that loop when the branches are easy to predict: long
+        // stretches of values from the same run, or runs taking turns
+        // with a fixed pattern. The kernels switch between three modes:
+        // - The probe merges values with branches and records the
+        //   lengths of the stretches of values taken from the same run.
+        //   When they are short and irregular, it hands over to the
+        //   branchless merge, otherwise to the branchy merge.
+        // - The branchless merge handles a block at a time and counts
+        //   how often it switches from one run to the other. After two
+        //   blocks in a row with at most one switch or with a switch
+        //   after every value, or after branchless_window blocks, the
+        //   kernel probes the runs again.
+        // - The branchy merge handles a chunk of values at a time with
+        //   the usual merge loop, and gallops through a run when a whole
+        //   chunk came from it. After a budget of chunks, the kernel
+        //   probes the runs again.
+
+        enum struct merge_mode
+        {
+            branchless,
+            probe,
+            branchy
+        };
+
+        struct merge_state
+        {
+            merge_mode mode = merge_mode::probe;
+            int branchless_blocks = 0;
+            int predictable_blocks = 0;
+            int whole_blocks = 0;
+
+            auto start_branchless()
+                -> void
+            {
+                mode = merge_mode::branchless;
+                branchless_blocks = 0;
+                predictable_blocks = 0;
+                whole_blocks = 0;
+            }
+
+            auto after_branchless_block(std::ptrdiff_t switches)
+                -> void
+            {
+                if (++branchless_blocks == branchless_window) {
+                    mode = merge_mode::probe;
+                } else if (switches <= 1 || switches == block_size - 1) {
+                    if (++predictable_blocks == 2) {
+                        mode = merge_mode::probe;
+                    }
+                } else {
+                    predictable_blocks = 0;
+                }
+            }
+
+            auto after_merge_network(bool whole_block)
+                -> void
+            {
+                whole_blocks = whole_block ? whole_blocks + 1 : 0;
+                if (whole_blocks == 2) {
+                    mode = merge_mode::branchy;
+                } else if (++branchless_blocks == branchless_window) {
+                    mode = merge_mode::probe;
+                }
+            }
+        };
+
+        // Records the length of a stretch of values taken from the same
+        // run during a probe, and returns whether the probe is over
+        struct probe_stats
+        {
+            std::ptrdiff_t stretches = 0;
+            std::ptrdiff_t values = 0;
+            std::ptrdiff_t changes = 0;
+            std::ptrdiff_t previous1 = 0;
+            std::ptrdiff_t previous2 = 0;
+
+            auto add(std::ptrdiff_t length, std::ptrdiff_t& previous)
+                -> bool
+            {
+                values += length;
+                changes += length != previous;
+                previous = length;
+                return ++stretches == stretches_window;
+            }
+
+            // Whether the stretches are unpredictable enough for the
+            // branchless merge to beat the branchy one: short on average,
+            // but not so short that the runs just take turns, and with
+            // lengths that keep changing instead of following a pattern
+            // that the branch predictor would learn
+            auto unpredictable() const
+                -> bool
+            {
+                return values > stretches_window + stretches_window / 3
+                    && values <= 3 * stretches_window
+                    && changes >= 3;
+            }
+        };
+
+        // The following functions work on local copies of the cursors
+        // and write them back once done: since the cursors are passed
+        // by reference, the compiler would otherwise have to reload
+        // them after every store to the output
+
+        // Merges a block of values without branches, both runs must
+        // hold at least a full block, returns the number of switches
+        template<typename Compare, typename T>
+        auto branchless_merge_forward(const T*& first1_ref, const T*& first2_ref, T*& result_ref, Compare& comp)
+            -> std::ptrdiff_t
+        {
+            auto first1 = first1_ref;
+            auto first2 = first2_ref;
+            auto result = result_ref;
+            std::ptrdiff_t switches = 0;
+            bool prev = comp(*first2, *first1);
+            for (auto size = block_size ; size != 0 ; --size) {
+                T value1 = *first1;
+                T value2 = *first2;
+                bool take2 = comp(value2, value1);
+                *result = take2 ? value2 : value1;
+                ++result;
+                first1 += not take2;
+                first2 += take2;
+                switches += take2 != prev;
+                prev = take2;
+            }
+            first1_ref = first1;
+            first2_ref = first2;
+            result_ref = result;
+            return switches;
+        }
+
+        template<typename Compare, typename T>
+        auto branchless_merge_backward(const T*& last1_ref, const T*& last2_ref, T*& result_ref, Compare& comp)
+            -> std::ptrdiff_t
+        {
+            auto last1 = last1_ref;
+            auto last2 = last2_ref;
+            auto result = result_ref;
+            std::ptrdiff_t switches = 0;
+            bool prev = comp(last2[-1], last1[-1]);
+            for (auto size = block_size ; size != 0 ; --size) {
+                T value1 = last1[-1];
+                T value2 = last2[-1];
+                bool take1 = comp(value2, value1);
+                --result;
+                *result = take1 ? value1 : value2;
+                last1 -= take1;
+                last2 -= not take1;
+                switches += take1 != prev;
+                prev = take1;
+            }
+            last1_ref = last1;
+            last2_ref = last2;
+            result_ref = result;
+            return switches;
+        }
+
+        // Merges values with branches while recording the lengths of
+        // the stretches of values taken from the same run, until a run
+        // is exhausted or enough stretches were seen to pick the next
+        // strategy; a stretch of probe_max_stretch values ends the probe
+        // early since the branchy merge is then the obvious choice
+        template<typename Compare, typename T>
+        auto probe_merge_forward(const T*& first1_ref, const T* last1,
+                                 const T*& first2_ref, const T* last2,
+                                 T*& result_ref, merge_state& state,
+                                 Compare& comp)
+            -> void
+        {
+            auto first1 = first1_ref;
+            auto first2 = first2_ref;
+            auto result = result_ref;
+            probe_stats stats;
+            std::ptrdiff_t count1 = 0;
+            std::ptrdiff_t count2 = 0;
+            state.mode = merge_mode::branchy;
+            while (true) {
+                if (comp(*first2, *first1)) {
+                    if (count1 != 0) {
+                        if (stats.add(count1, stats.previous1)) break;
+                        count1 = 0;
+                    }
+                    *result = *first2;
+                    ++result;
+                    ++first2;
+                    if (first2 == last2) break;
+                    if (++count2 == probe_max_stretch) break;
+                } else {
+                    if (count2 != 0) {
+                        if (stats.add(count2, stats.previous2)) break;
+                        count2 = 0;
+                    }
+                    *result = *first1;
+                    ++result;
+                    ++first1;
+                    if (first1 == last1) break;
+                    if (++count1 == probe_max_stretch) break;
+                }
+            }
+            if (stats.stretches == stretches_window && stats.unpredictable()) {
+                state.start_branchless();
+            }
+            first1_ref = first1;
+            first2_ref = first2;
+            result_ref = result;
+        }
+
+        template<typename Compare, typename T>
+        auto probe_merge_backward(const T* first1, const T*& last1_ref,
+                                  const T* first2, const T*& last2_ref,
+                                  T*& result_ref, merge_state& state,
+                                  Compare& comp)
+            -> void
+        {
+            auto last1 = last1_ref;
+            auto last2 = last2_ref;
+            auto result = result_ref;
+            probe_stats stats;
+            std::ptrdiff_t count1 = 0;
+            std::ptrdiff_t count2 = 0;
+            state.mode = merge_mode::branchy;
+            while (true) {
+                if (comp(last2[-1], last1[-1])) {
+                    if (count2 != 0) {
+                        if (stats.add(count2, stats.previous2)) break;
+                        count2 = 0;
+                    }
+                    --result;
+                    --last1;
+                    *result = *last1;
+                    if (first1 == last1) break;
+                    if (++count1 == probe_max_stretch) break;
+                } else {
+                    if (count1 != 0) {
+                        if (stats.add(count1, stats.previous1)) break;
+                        count1 = 0;
+                    }
+                    --result;
+                    --last2;
+                    *result = *last2;
+                    if (first2 == last2) break;
+                    if (++count2 == probe_max_stretch) break;
+                }
+            }
+            if (stats.stretches == stretches_window && stats.unpredictable()) {
+                state.start_branchless();
+            }
+            last1_ref = last1;
+            last2_ref = last2;
+            result_ref = result;
+        }
+
+        // Merges values with branches by chunks of chunk_size values,
+        // without any bookkeeping in the loop: when a chunk only took
+        // values from one run, the kernel gallops through that run and
+        // moves the values found this way at once. After budget chunks
+        // or when a run doesn't hold a full chunk anymore, it stops so
+        // that the kernel probes the runs again
+        template<typename Compare, typename T>
+        auto branchy_merge_forward(const T*& first1_ref, const T* last1,
+                                   const T*& first2_ref, const T* last2,
+                                   T*& result_ref, merge_state& state,
+                                   std::ptrdiff_t budget,
+                                   Compare& comp)
+            -> void
+        {
+            auto first1 = first1_ref;
+            auto first2 = first2_ref;
+            auto result = result_ref;
+            while (budget-- > 0 && last1 - first1 >= chunk_size && last2 - first2 >= chunk_size) {
+                auto start1 = first1;
+                auto start2 = first2;
+                for (std::ptrdiff_t i = 0 ; i < chunk_size ; ++i) {
+                    if (comp(*first2, *first1)) {
+                        *result = *first2;
+                        ++first2;
+                    } else {
+                        *result = *first1;
+                        ++first1;
+                    }
+                    ++result;
+                }
+
+                if (first1 == start1) {
+                    if (first2 == last2) break;
+                    T head = *first1;
+                    if (comp(*first2, head)) {
+                        auto mid = gallop_forward(first2, last2, [&](const T& value) {
+                            return comp(value, head);
+                        });
+                        result = move_values(first2, mid, result);
+                        first2 = mid;
+                    }
+                } else if (first2 == start2) {
+                    if (first1 == last1) break;
+                    T head = *first2;
+                    if (not comp(head, *first1)) {
+                        auto mid = gallop_forward(first1, last1, [&](const T& value) {
+                            return not comp(head, value);
+                        });
+                        result = move_values(first1, mid, result);
+                        first1 = mid;
+                    }
+                }
+            }
+            state.mode = merge_mode::probe;
+            first1_ref = first1;
+            first2_ref = first2;
+            result_ref = result;
+        }
+
+        template<typename Compare, typename T>
+        auto branchy_merge_backward(const T* first1, const T*& last1_ref,
+                                    const T* first2, const T*& last2_ref,
+                                    T*& result_ref, merge_state& state,
+                                    std::ptrdiff_t budget,
+                                    Compare& comp)
+            -> void
+        {
+            auto last1 = last1_ref;
+            auto last2 = last2_ref;
+            auto result = result_ref;
+            while (budget-- > 0 && last1 - first1 >= chunk_size && last2 - first2 >= chunk_size) {
+                auto start1 = last1;
+                auto start2 = last2;
+                for (std::ptrdiff_t i = 0 ; i < chunk_size ; ++i) {
+                    --result;
+                    if (comp(last2[-1], last1[-1])) {
+                        --last1;
+                        *result = *last1;
+                    } else {
+                        --last2;
+                        *result = *last2;
+                    }
+                }
+
+                if (last2 == start2) {
+                    if (first1 == last1) break;
+                    T tail = last2[-1];
+                    if (comp(tail, last1[-1])) {
+                        auto mid = gallop_backward(first1, last1, [&](const T& value) {
+                            return comp(tail, value);
+                        });
+                        result = move_values_backward(mid, last1, result);
+                        last1 = mid;
+                    }
+                } else if (last1 == start1) {
+                    if (first2 == last2) break;
+                    T tail = last1[-1];
+                    if (not comp(last2[-1], tail)) {
+                        auto mid = gallop_backward(first2, last2, [&](const T& value) {
+                            return not comp(value, tail);
+                        });
+                        result = move_values_backward(mid, last2, result);
+                        last2 = mid;
+                    }
+                }
+            }
+            state.mode = merge_mode::probe;
+            last1_ref = last1;
+            last2_ref = last2;
+            result_ref = result;
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Scalar kernels
+
+        template<typename Compare, typename T>
+        auto merge_forward_scalar(const T* first1, const T* last1,
+                                  const T* first2, const T* last2,
+                                  T* result,
+                                  Compare& comp)
+            -> T*
+        {
+            merge_state state;
+            while (first1 != last1 && first2 != last2) {
+                if (last1 - first1 < block_size) {
+                    // Short first run: gallop through the second run
+                    // to find where the head of the first one goes
+                    T head = *first1;
+                    auto mid = first2;
+                    if (comp(*first2, head)) {
+                        mid = gallop_forward(first2, last2, [&](const T& value) {
+                            return comp(value, head);
+                        });
+                    }
+                    result = move_values(first2, mid, result);
+                    first2 = mid;
+                    *result = head;
+                    ++result;
+                    ++first1;
+                    continue;
+                }
+                if (last2 - first2 < block_size) {
+                    // Short second run: same thing the other way
+                    T head = *first2;
+                    auto mid = first1;
+                    if (not comp(head, *first1)) {
+                        mid = gallop_forward(first1, last1, [&](const T& value) {
+                            return not comp(head, value);
+                        });
+                    }
+                    result = move_values(first1, mid, result);
+                    first1 = mid;
+                    *result = head;
+                    ++result;
+                    ++first2;
+                    continue;
+                }
+
+                switch (state.mode) {
+                    case merge_mode::branchless:
+                        state.after_branchless_block(
+                            branchless_merge_forward(first1, first2, result, comp)
+                        );
+                        break;
+                    case merge_mode::probe:
+                        probe_merge_forward(first1, last1, first2, last2, result, state, comp);
+                        break;
+                    case merge_mode::branchy:
+                        branchy_merge_forward(first1, last1, first2, last2, result, state,
+                                                       branchy_budget, comp);
+                        break;
+                }
+            }
+
+            result = move_values(first1, last1, result);
+            return move_values(first2, last2, result);
+        }
+
+        template<typename Compare, typename T>
+        auto merge_backward_scalar(const T* first1, const T* last1,
+                                   const T* first2, const T* last2,
+                                   T* result,
+                                   Compare& comp)
+            -> T*
+        {
+            merge_state state;
+            while (first1 != last1 && first2 != last2) {
+                if (last1 - first1 < block_size) {
+                    // Short first run: gallop through the second run
+                    // to find where the tail of the first one goes
+                    T tail = last1[-1];
+                    auto mid = last2;
+                    if (not comp(last2[-1], tail)) {
+                        mid = gallop_backward(first2, last2, [&](const T& value) {
+                            return not comp(value, tail);
+                        });
+                    }
+                    result = move_values_backward(mid, last2, result);
+                    last2 = mid;
+                    --result;
+                    *result = tail;
+                    --last1;
+                    continue;
+                }
+                if (last2 - first2 < block_size) {
+                    // Short second run: same thing the other way
+                    T tail = last2[-1];
+                    auto mid = last1;
+                    if (comp(tail, last1[-1])) {
+                        mid = gallop_backward(first1, last1, [&](const T& value) {
+                            return comp(tail, value);
+                        });
+                    }
+                    result = move_values_backward(mid, last1, result);
+                    last1 = mid;
+                    --result;
+                    *result = tail;
+                    --last2;
+                    continue;
+                }
+
+                switch (state.mode) {
+                    case merge_mode::branchless:
+                        state.after_branchless_block(
+                            branchless_merge_backward(last1, last2, result, comp)
+                        );
+                        break;
+                    case merge_mode::probe:
+                        probe_merge_backward(first1, last1, first2, last2, result, state, comp);
+                        break;
+                    case merge_mode::branchy:
+                        branchy_merge_backward(first1, last1, first2, last2, result, state,
+                                                        branchy_budget, comp);
+                        break;
+                }
+            }
+
+            result = move_values_backward(first2, last2, result);
+            return move_values_backward(first1, last1, result);
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Bitonic merge networks
+        //
+        // Every vector type provides the operations needed to merge
+        // two sorted registers of 8 elements: the second register is
+        // reversed to form a bitonic sequence with the first one,
+        // the element-wise min and max of both registers are computed
+        // then every register is sorted with a bitonic half-cleaner
+        // applied to elements 4, 2 then 1 lane apart.
+
+        template<typename T>
+        struct merge_vector
+        {
+            static constexpr bool available = false;
+        };
+
+#if CPPSORT_AVX2_AVAILABLE
+        struct avx2_merge_vector_base
+        {
+            using type = __m256i;
+            static constexpr bool available = true;
+
+            static auto load(const void* ptr)
+                -> type
+            {
+                return _mm256_loadu_si256(static_cast<const __m256i*>(ptr));
+            }
+
+            static auto store(void* ptr, type value)
+                -> void
+            {
+                _mm256_storeu_si256(static_cast<__m256i*>(ptr), value);
+            }
+
+            static auto reverse(type value)
+                -> type
+            {
+                return _mm256_permutevar8x32_epi32(value, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+            }
+
+            template<typename Lo, typename Hi>
+            static auto half_clean(type value, Lo lo, Hi hi)
+                -> type
+            {
+                type tmp = _mm256_permute2x128_si256(value, value, 0x01);
+                value = _mm256_blend_epi32(lo(value, tmp), hi(value, tmp), 0xF0);
+                tmp = _mm256_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+                value = _mm256_blend_epi32(lo(value, tmp), hi(value, tmp), 0xCC);
+                tmp = _mm256_shuffle_epi32(value, _MM_SHUFFLE(2, 3, 0, 1));
+                return _mm256_blend_epi32(lo(value, tmp), hi(value, tmp), 0xAA);
+            }
+        };
+
+        template<typename T, bool Signed = std::is_signed<T>::value>
+        struct avx2_merge_vector;
+
+        template<typename T>
+        struct avx2_merge_vector<T, true>:
+            avx2_merge_vector_base
+        {
+            static auto min(type lhs, type rhs) -> type { return _mm256_min_epi32(lhs, rhs); }
+            static auto max(type lhs, type rhs) -> type { return _mm256_max_epi32(lhs, rhs); }
+        };
+
+        template<typename T>
+        struct avx2_merge_vector<T, false>:
+            avx2_merge_vector_base
+        {
+            static auto min(type lhs, type rhs) -> type { return _mm256_min_epu32(lhs, rhs); }
+            static auto max(type lhs, type rhs) -> type { return _mm256_max_epu32(lhs, rhs); }
+        };
+#endif
+
+#if CPPSORT_AVX512F_AVAILABLE
+        // The masked forms of the intrinsics are used with a full mask:
+        // the unmasked ones trigger spurious -Wuninitialized warnings
+        // with some versions of GCC
+        struct avx512_merge_vector_base
+        {
+            using type = __m512i;
+            static constexpr bool available = true;
+
+            static auto load(const void* ptr)
+                -> type
+            {
+                return _mm512_loadu_si512(ptr);
+            }
+
+            static auto store(void* ptr, type value)
+                -> void
+            {
+                _mm512_storeu_si512(ptr, value);
+            }
+
+            static auto reverse(type value)
+                -> type
+            {
+                return _mm512_mask_permutexvar_epi64(value, 0xFF, _mm512_set_epi64(0, 1, 2, 3, 4, 5, 6, 7), value);
+            }
+
+            template<typename Lo, typename Hi>
+            static auto half_clean(type value, Lo lo, Hi hi)
+                -> type
+            {
+                type tmp = _mm512_mask_shuffle_i64x2(value, 0xFF, value, value, _MM_SHUFFLE(1, 0, 3, 2));
+                value = _mm512_mask_blend_epi64(0xF0, lo(value, tmp), hi(value, tmp));
+                tmp = _mm512_mask_permutex_epi64(value, 0xFF, value, _MM_SHUFFLE(1, 0, 3, 2));
+                value = _mm512_mask_blend_epi64(0xCC, lo(value, tmp), hi(value, tmp));
+                tmp = _mm512_mask_permutex_epi64(value, 0xFF, value, _MM_SHUFFLE(2, 3, 0, 1));
+                return _mm512_mask_blend_epi64(0xAA, lo(value, tmp), hi(value, tmp));
+            }
+        };
+
+        template<typename T, bool Signed = std::is_signed<T>::value>
+        struct avx512_merge_vector;
+
+        template<typename T>
+        struct avx512_merge_vector<T, true>:
+            avx512_merge_vector_base
+        {
+            static auto min(type lhs, type rhs) -> type { return _mm512_mask_min_epi64(lhs, 0xFF, lhs, rhs); }
+            static auto max(type lhs, type rhs) -> type { return _mm512_mask_max_epi64(lhs, 0xFF, lhs, rhs); }
+        };
+
+        template<typename T>
+        struct avx512_merge_vector<T, false>:
+            avx512_merge_vector_base
+        {
+            static auto min(type lhs, type rhs) -> type { return _mm512_mask_min_epu64(lhs, 0xFF, lhs, rhs); }
+            static auto max(type lhs, type rhs) -> type { return _mm512_mask_max_epu64(lhs, 0xFF, lhs, rhs); }
+        };
+#endif
+
+#if CPPSORT_AVX2_AVAILABLE
+        template<typename T>
+        struct select_merge_vector_32:
+            std::conditional<
+                std::is_integral<T>::value && not std::is_same<T, bool>::value && sizeof(T) == 4,
+                avx2_merge_vector<T>,
+                merge_vector<T>
+            >
+        {};
+#else
+        template<typename T>
+        struct select_merge_vector_32
+        {
+            using type = merge_vector<T>;
+        };
+#endif
+
+#if CPPSORT_AVX512F_AVAILABLE
+        template<typename T>
+        struct select_merge_vector_64:
+            std::conditional<
+                std::is_integral<T>::value && sizeof(T) == 8,
+                avx512_merge_vector<T>,
+                typename select_merge_vector_32<T>::type
+            >
+        {};
+#else
+        template<typename T>
+        struct select_merge_vector_64:
+            select_merge_vector_32<T>
+        {};
+#endif
+
+        template<typename T>
+        using merge_vector_t = typename select_merge_vector_64<T>::type;
+
+        // Merges the sorted registers lhs and rhs so that lhs holds the
+        // 8 first elements in the comparison order, and rhs the 8 last
+        template<typename Vector, simd_order Order>
+        auto bitonic_merge(typename Vector::type& lhs, typename Vector::type& rhs)
+            -> void
+        {
+            using type = typename Vector::type;
+            constexpr bool ascending = Order == simd_order::ascending;
+            auto lo = [](type x, type y) { return ascending ? Vector::min(x, y) : Vector::max(x, y); };
+            auto hi = [](type x, type y) { return ascending ? Vector::max(x, y) : Vector::min(x, y); };
+
+            rhs = Vector::reverse(rhs);
+            type low = lo(lhs, rhs);
+            type high = hi(lhs, rhs);
+            lhs = Vector::half_clean(low, lo, hi);
+            rhs = Vector::half_clean(high, lo, hi);
+        }
+
+        ////////////////////////////////////////////////////////////
+        // SIMD kernels
+        //
+        // The registers are filled with blocks of 8 elements from
+        // the runs, one register always holding the 8 pending
+        // elements that still have to be merged with the next block,
+        // which comes from the run whose next element comes first.
+        // The merge networks replace the branchless merge of the
+        // scalar kernels: when the probe doesn't pick them, or when
+        // two blocks in a row come before the head of the other run,
+        // the pending elements are flushed and the kernel falls back
+        // to the branchy merge. When one of the runs doesn't have a
+        // full block left, the pending elements are merged with the
+        // remaining elements of that run in a small local buffer,
+        // which is then merged with the other run by the scalar
+        // kernel.
+        //
+        // These kernels only handle integers: since equivalent values
+        // can't be distinguished, the merge networks and the flushes
+        // don't have to care about the order of the runs.
+
+        template<typename Compare, typename T>
+        auto flush_forward(const T* pending, const T* pending_end,
+                           const T*& first1, const T* last1,
+                           const T*& first2, const T* last2,
+                           T* result,
+                           Compare& comp)
+            -> T*
+        {
+            while (pending != pending_end) {
+                if (first1 != last1 && comp(*first1, *pending) &&
+                    (first2 == last2 || not comp(*first2, *first1))) {
+                    *result = *first1;
+                    ++first1;
+                } else if (first2 != last2 && comp(*first2, *pending)) {
+                    *result = *first2;
+                    ++first2;
+                } else {
+                    *result = *pending;
+                    ++pending;
+                }
+                ++result;
+            }
+            return result;
+        }
+
+        template<typename Compare, typename T>
+        auto flush_backward(const T* pending, const T* pending_end,
+                            const T* first1, const T*& last1,
+                            const T* first2, const T*& last2,
+                            T* result,
+                            Compare& comp)
+            -> T*
+        {
+            while (pending != pending_end) {
+                --result;
+                if (first1 != last1 && comp(pending_end[-1], last1[-1]) &&
+                    (first2 == last2 || not comp(last1[-1], last2[-1]))) {
+                    --last1;
+                    *result = *last1;
+                } else if (first2 != last2 && comp(pending_end[-1], last2[-1])) {
+                    --last2;
+                    *result = *last2;
+                } else {
+                    --pending_end;
+                    *result = *pending_end;
+                }
+            }
+            return result;
+        }
+
+        template<simd_order Order, typename Compare, typename T>
+        auto merge_forward_simd(const T* first1, const T* last1,
+                                const T* first2, const T* last2,
+                                T* result, Compare& comp, std::true_type)
+            -> T*
+        {
+            using vector = merge_vector_t<T>;
+            using type = typename vector::type;
+
+            merge_state state;
+            T pending[block_size];
+            type lhs, rhs;
+            bool has_pending = false;
+            while (last1 - first1 >= block_size && last2 - first2 >= block_size) {
+                bool whole_block = false;
+                if (not has_pending) {
+                    if (state.mode == merge_mode::probe) {
+                        probe_merge_forward(first1, last1, first2, last2, result, state, comp);
+                        continue;
+                    }
+                    if (state.mode == merge_mode::branchy) {
+                        branchy_merge_forward(first1, last1, first2, last2, result, state,
+                                                       simd_branchy_budget, comp);
+                        continue;
+                    }
+                    lhs = vector::load(first1);
+                    rhs = vector::load(first2);
+                    first1 += block_size;
+                    first2 += block_size;
+                    has_pending = true;
+                } else {
+                    if (state.mode != merge_mode::branchless) {
+                        vector::store(pending, rhs);
+                        result = flush_forward(pending, pending + block_size,
+                                                        first1, last1, first2, last2, result, comp);
+                        has_pending = false;
+                        continue;
+                    }
+                    bool take2 = comp(*first2, *first1);
+                    whole_block = take2 ? comp(first2[block_size - 1], *first1)
+                                        : not comp(*first2, first1[block_size - 1]);
+                    lhs = vector::load(take2 ? first2 : first1);
+                    first1 += take2 ? 0 : block_size;
+                    first2 += take2 ? block_size : 0;
+                }
+                bitonic_merge<vector, Order>(lhs, rhs);
+                vector::store(result, lhs);
+                result += block_size;
+                state.after_merge_network(whole_block);
+            }
+
+            if (not has_pending) {
+                return merge_forward_scalar(first1, last1, first2, last2, result, comp);
+            }
+
+            // Merge the pending elements with the shortest run
+            T tail[2 * block_size];
+            vector::store(pending, rhs);
+            if (last1 - first1 < block_size) {
+                auto tail_end = merge_forward_scalar(pending, pending + block_size,
+                                                              first1, last1, tail, comp);
+                return merge_forward_scalar(tail, tail_end, first2, last2, result, comp);
+            } else {
+                auto tail_end = merge_forward_scalar(pending, pending + block_size,
+                                                              first2, last2, tail, comp);
+                return merge_forward_scalar(first1, last1, tail, tail_end, result, comp);
+            }
+        }
+
+        template<simd_order Order, typename Compare, typename T>
+        auto merge_backward_simd(const T* first1, const T* last1,
+                                 const T* first2, const T* last2,
+                                 T* result, Compare& comp, std::true_type)
+            -> T*
+        {
+            using vector = merge_vector_t<T>;
+            using type = typename vector::type;
+
+            merge_state state;
+            T pending[block_size];
+            type lhs, rhs;
+            bool has_pending = false;
+            while (last1 - first1 >= block_size && last2 - first2 >= block_size) {
+                bool whole_block = false;
+                if (not has_pending) {
+                    if (state.mode == merge_mode::probe) {
+                        probe_merge_backward(first1, last1, first2, last2, result, state, comp);
+                        continue;
+                    }
+                    if (state.mode == merge_mode::branchy) {
+                        branchy_merge_backward(first1, last1, first2, last2, result, state,
+                                                        simd_branchy_budget, comp);
+                        continue;
+                    }
+                    last1 -= block_size;
+                    last2 -= block_size;
+                    lhs = vector::load(last1);
+                    rhs = vector::load(last2);
+                    has_pending = true;
+                } else {
+                    if (state.mode != merge_mode::branchless) {
+                        vector::store(pending, lhs);
+                        result = flush_backward(pending, pending + block_size,
+                                                         first1, last1, first2, last2, result, comp);
+                        has_pending = false;
+                        continue;
+                    }
+                    bool take1 = comp(last2[-1], last1[-1]);
+                    whole_block = take1 ? comp(last2[-1], last1[-block_size])
+                                        : not comp(last2[-block_size], last1[-1]);
+                    last1 -= take1 ? block_size : 0;
+                    last2 -= take1 ? 0 : block_size;
+                    rhs = vector::load(take1 ? last1 : last2);
+                }
+                bitonic_merge<vector, Order>(lhs, rhs);
+                result -= block_size;
+                vector::store(result, rhs);
+                state.after_merge_network(whole_block);
+            }
+
+            if (not has_pending) {
+                return merge_backward_scalar(first1, last1, first2, last2, result, comp);
+            }
+
+            // Merge the pending elements with the shortest run
+            T tail[2 * block_size];
+            vector::store(pending, lhs);
+            auto tail_last = tail + 2 * block_size;
+            if (last1 - first1 < block_size) {
+                auto tail_first = merge_backward_scalar(first1, last1, pending, pending + block_size,
+                                                                 tail_last, comp);
+                return merge_backward_scalar(tail_first, tail_last, first2, last2, result, comp);
+            } else {
+                auto tail_first = merge_backward_scalar(pending, pending + block_size, first2, last2,
+                                                                 tail_last, comp);
+                return merge_backward_scalar(first1, last1, tail_first, tail_last, result, comp);
+            }
+        }
+
+        template<simd_order Order, typename Compare, typename T>
+        auto merge_forward_simd(const T* first1, const T* last1,
+                                const T* first2, const T* last2,
+                                T* result, Compare& comp, std::false_type)
+            -> T*
+        {
+            return merge_forward_scalar(first1, last1, first2, last2, result, comp);
+        }
+
+        template<simd_order Order, typename Compare, typename T>
+        auto merge_backward_simd(const T* first1, const T* last1,
+                                 const T* first2, const T* last2,
+                                 T* result, Compare& comp, std::false_type)
+            -> T*
+        {
+            return merge_backward_scalar(first1, last1, first2, last2, result, comp);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Kernel selection
+    //
+    // The scalar kernels copy the values and move whole stretches
+    // of them with memmove, which is valid for any trivially
+    // copyable type, with any comparison and projections that
+    // accept const values. The merge networks additionally need
+    // arithmetic values compared directly with a comparison known
+    // in advance.
+
+    namespace merge_kernel_detail
+    {
+        // Compares a value of the second run with a value of the first
+        // run, which is the only kind of comparison the scalar kernels
+        // perform, so that each run can have its own projection
+        template<typename Compare, typename Projection1, typename Projection2>
+        struct run_compare
+        {
+            Compare& compare;
+            Projection1& projection1;
+            Projection2& projection2;
+
+            template<typename T>
+            auto operator()(const T& value2, const T& value1)
+                -> bool
+            {
+                auto&& comp = utility::as_function(compare);
+                auto&& proj1 = utility::as_function(projection1);
+                auto&& proj2 = utility::as_function(projection2);
+                return comp(proj2(value2), proj1(value1));
+            }
+        };
+
+        // The kernels only hold const pointers to the runs, so the
+        // comparison has to accept const values
+        template<typename T, typename Compare, typename Projection1, typename Projection2>
+        using const_compare_t = decltype(utility::as_function(std::declval<Compare&>())(
+            utility::as_function(std::declval<Projection2&>())(std::declval<const T&>()),
+            utility::as_function(std::declval<Projection1&>())(std::declval<const T&>())
+        ));
+    }
+
+    template<typename Iterator1, typename Iterator2, typename OutputIterator,
+             typename Compare, typename Projection1, typename Projection2>
+    struct use_merge_kernel:
+        conjunction<
+            std::is_trivially_copyable<value_type_t<OutputIterator>>,
+            std::is_same<value_type_t<Iterator1>, value_type_t<OutputIterator>>,
+            std::is_same<value_type_t<Iterator2>, value_type_t<OutputIterator>>,
+            is_contiguous_iterator<Iterator1>,
+            is_contiguous_iterator<Iterator2>,
+            is_contiguous_iterator<OutputIterator>,
+            is_detected<
+                merge_kernel_detail::const_compare_t,
+                value_type_t<OutputIterator>, Compare, Projection1, Projection2
+            >
+        >
+    {};
+
+    template<typename T, typename Compare, typename Projection1, typename Projection2>
+    struct use_simd_merge_kernel:
+        conjunction<
+            std::is_arithmetic<T>,
+            negation<std::is_same<T, bool>>,
+            std::integral_constant<bool, simd_compare_order<Compare>::value != simd_order::unsupported>,
+            is_identity_projection<Projection1>,
+            is_identity_projection<Projection2>,
+            std::integral_constant<bool, merge_kernel_detail::merge_vector_t<T>::available>
+        >
+    {};
+
+    ////////////////////////////////////////////////////////////
+    // Kernel entry points
+    //
+    // Both runs must be non-empty, the forward merge returns the
+    // end of the output and the backward merge its beginning
+
+    template<typename Iterator1, typename Iterator2, typename OutputIterator,
+             typename Compare, typename Projection1, typename Projection2>
+    auto merge_kernel_forward(Iterator1 first1, Iterator1 last1,
+                              Iterator2 first2, Iterator2 last2,
+                              OutputIterator result, Compare compare,
+                              Projection1 projection1, Projection2 projection2,
+                              std::true_type)
+        -> OutputIterator
+    {
+        using value_type = value_type_t<OutputIterator>;
+        using use_simd = use_simd_merge_kernel<value_type, Compare, Projection1, Projection2>;
+        CPPSORT_ASSERT(first1 != last1);
+        CPPSORT_ASSERT(first2 != last2);
+
+        merge_kernel_detail::run_compare<Compare, Projection1, Projection2> comp = {
+            compare, projection1, projection2
+        };
+        const value_type* ptr1 = std::addressof(*first1);
+        const value_type* ptr2 = std::addressof(*first2);
+        value_type* out = std::addressof(*result);
+        auto out_end = merge_kernel_detail::merge_forward_simd<simd_compare_order<Compare>::value>(
+            ptr1, ptr1 + (last1 - first1),
+            ptr2, ptr2 + (last2 - first2),
+            out, comp, std::integral_constant<bool, use_simd::value>{}
+        );
+        return result + (out_end - out);
+    }
+
+    template<typename Iterator1, typename Iterator2, typename OutputIterator,
+             typename Compare, typename Projection1, typename Projection2>
+    auto merge_kernel_backward(Iterator1 first1, Iterator1 last1,
+                               Iterator2 first2, Iterator2 last2,
+                               OutputIterator result, Compare compare,
+                               Projection1 projection1, Projection2 projection2,
+                               std::true_type)
+        -> OutputIterator
+    {
+        using value_type = value_type_t<OutputIterator>;
+        using use_simd = use_simd_merge_kernel<value_type, Compare, Projection1, Projection2>;
+        CPPSORT_ASSERT(first1 != last1);
+        CPPSORT_ASSERT(first2 != last2);
+
+        merge_kernel_detail::run_compare<Compare, Projection1, Projection2> comp = {
+            compare, projection1, projection2
+        };
+        const value_type* ptr1 = std::addressof(*first1);
+        const value_type* ptr2 = std::addressof(*first2);
+        // result is the end of the output, it can't be dereferenced
+        value_type* out = std::addressof(*(result - 1)) + 1;
+        auto out_first = merge_kernel_detail::merge_backward_simd<simd_compare_order<Compare>::value>(
+            ptr1, ptr1 + (last1 - first1),
+            ptr2, ptr2 + (last2 - first2),
+            out, comp, std::integral_constant<bool, use_simd::value>{}
+        );
+        return result - (out - out_first);
+    }
+
+    // Overloads for the iterators the kernel doesn't handle, they
+    // only exist so that the calls above compile without C++17's
+    // if constexpr and are never called
+
+    template<typename Iterator1, typename Iterator2, typename OutputIterator,
+             typename Compare, typename Projection1, typename Projection2>
+    auto merge_kernel_forward(Iterator1, Iterator1, Iterator2, Iterator2,
+                              OutputIterator result, Compare, Projection1, Projection2,
+                              std::false_type)
+        -> OutputIterator
+    {
+        CPPSORT_UNREACHABLE;
+        return result;
+    }
+
+    template<typename Iterator1, typename Iterator2, typename OutputIterator,
+             typename Compare, typename Projection1, typename Projection2>
+    auto merge_kernel_backward(Iterator1, Iterator1, Iterator2, Iterator2,
+                               OutputIterator result, Compare, Projection1, Projection2,
+                               std::false_type)
+        -> OutputIterator
+    {
+        CPPSORT_UNREACHABLE;
+        return result;
+    }
+}}
+
+#endif // CPPSORT_DETAIL_MERGE_KERNEL_H_
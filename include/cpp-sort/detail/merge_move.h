@@ -13,6 +13,7 @@
 #include <cpp-sort/utility/iter_move.h>
 #include "config.h"
 #include "is_sorted_until.h"
+#include "merge_kernel.h"
 #include "move.h"
 
 namespace cppsort
@@ -43,6 +44,16 @@ namespace detail
             return detail::move(first1, last1, result);
         }
 
+        using use_kernel = use_merge_kernel<
+            InputIterator1, InputIterator2, OutputIterator,
+            Compare, Projection1, Projection2
+        >;
+        if (use_kernel::value) {
+            return merge_kernel_forward(first1, last1, first2, last2, result,
+                                        std::move(compare), std::move(projection1),
+                                        std::move(projection2), use_kernel{});
+        }
+
         while (true) {
             CPPSORT_ASSUME(first1 != last1);
             CPPSORT_ASSUME(first2 != last2);
@@ -8,6 +8,7 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <cstddef>
 #include <iterator>
 #include <utility>
 #include <cpp-sort/utility/as_function.h>
@@ -22,6 +23,43 @@ namespace cppsort
 {
 namespace detail
 {
+    // Non-owning view over memory provided by the caller, big
+    // enough to merge any pair of partitions, which thus never
+    // needs to grow
+    template<typename T>
+    class merge_sort_buffer_view
+    {
+        public:
+
+            merge_sort_buffer_view(T* buffer, std::ptrdiff_t buffer_size) noexcept:
+                buffer(buffer),
+                buffer_size(buffer_size)
+            {}
+
+            auto data() const noexcept
+                -> T*
+            {
+                return buffer;
+            }
+
+            auto size() const noexcept
+                -> std::ptrdiff_t
+            {
+                return buffer_size;
+            }
+
+            auto try_grow(std::ptrdiff_t) noexcept
+                -> bool
+            {
+                return false;
+            }
+
+        private:
+
+            T* buffer;
+            std::ptrdiff_t buffer_size;
+    };
+
     template<typename ForwardIterator, typename Compare, typename Projection>
     auto merge_sort_impl(ForwardIterator first, difference_type_t<ForwardIterator> size,
                          temporary_buffer<rvalue_type_t<ForwardIterator>>&& buffer,
@@ -73,13 +111,14 @@ namespace detail
         return std::move(buffer);
     }
 
-    template<typename BidirectionalIterator, typename Compare, typename Projection>
+    template<typename BidirectionalIterator, typename Buffer,
+             typename Compare, typename Projection>
     auto merge_sort_impl(BidirectionalIterator first, BidirectionalIterator last,
                          difference_type_t<BidirectionalIterator> size,
-                         temporary_buffer<rvalue_type_t<BidirectionalIterator>>&& buffer,
+                         Buffer&& buffer,
                          Compare compare, Projection projection,
                          std::bidirectional_iterator_tag tag)
-        -> temporary_buffer<rvalue_type_t<BidirectionalIterator>>
+        -> Buffer
     {
         auto&& comp = utility::as_function(compare);
         auto&& proj = utility::as_function(projection);
@@ -162,6 +201,27 @@ namespace detail
                         std::move(compare), std::move(projection), tag);
     }
 
+    template<typename BidirectionalIterator, typename Compare, typename Projection>
+    auto merge_sort(BidirectionalIterator first, BidirectionalIterator last,
+                    difference_type_t<BidirectionalIterator> size,
+                    Compare compare, Projection projection,
+                    rvalue_type_t<BidirectionalIterator>* buffer)
+        -> void
+    {
+        // The buffer must be able to hold size / 2 elements, merges
+        // never need more memory
+        if (size < 40) {
+            insertion_sort(std::move(first), std::move(last),
+                           std::move(compare), std::move(projection));
+            return;
+        }
+
+        merge_sort_impl(std::move(first), std::move(last), size,
+                        merge_sort_buffer_view<rvalue_type_t<BidirectionalIterator>>(buffer, size / 2),
+                        std::move(compare), std::move(projection),
+                        std::bidirectional_iterator_tag{});
+    }
+
     template<typename ForwardIterator, typename Compare, typename Projection>
     auto merge_sort(ForwardIterator first, ForwardIterator last,
                     difference_type_t<ForwardIterator> size,
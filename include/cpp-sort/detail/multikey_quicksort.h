@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_MULTIKEY_QUICKSORT_H_
+#define CPPSORT_DETAIL_MULTIKEY_QUICKSORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+#include <cpp-sort/utility/apply_permutation.h>
+#include <cpp-sort/utility/as_function.h>
+#include "iterator_traits.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Multikey quicksort
+    //
+    // Bentley & Sedgewick's three-way radix quicksort working
+    // on the keys produced by a string key extractor instead of
+    // on raw characters. The algorithm doesn't move the strings
+    // around: it sorts an array of indices instead, alongside an
+    // array holding the key currently compared for each string,
+    // and another one holding the position right after that key
+    // in the string. That last array is a cache of the longest
+    // prefix that a string is known to share with its partition:
+    // a character that was already examined is never extracted
+    // again, whatever the comparison function. The permutation
+    // is applied to the original collection once sorted.
+
+    template<typename RandomAccessIterator, typename KeyExtractor, typename Projection>
+    class multikey_quicksort_impl
+    {
+        private:
+
+            using difference_type = difference_type_t<RandomAccessIterator>;
+            using key_type = typename KeyExtractor::key_type;
+
+            // Under this size, partitions are sorted with an
+            // insertion sort comparing the strings directly
+            static constexpr difference_type insertion_limit = 12;
+
+            // Position marking that a string was fully examined
+            static constexpr std::size_t exhausted = (std::numeric_limits<std::size_t>::max)();
+
+            RandomAccessIterator first;
+            const KeyExtractor& extractor;
+            Projection projection;
+
+            std::vector<key_type> keys;
+            std::vector<std::size_t> positions;
+            std::vector<difference_type> indices;
+
+        public:
+
+            multikey_quicksort_impl(RandomAccessIterator first, difference_type size,
+                                    const KeyExtractor& extractor, Projection projection):
+                first(first),
+                extractor(extractor),
+                projection(std::move(projection)),
+                keys(size),
+                positions(size, 0),
+                indices(size)
+            {
+                for (difference_type idx = 0 ; idx < size ; ++idx) {
+                    indices[idx] = idx;
+                    next_key(idx);
+                }
+            }
+
+            auto sort()
+                -> void
+            {
+                auto size = static_cast<difference_type>(indices.size());
+                sort(0, size);
+                utility::apply_permutation(first, first + size,
+                                           indices.begin(), indices.end());
+            }
+
+        private:
+
+            auto next_key(difference_type idx)
+                -> void
+            {
+                auto&& proj = utility::as_function(projection);
+                auto& pos = positions[idx];
+                auto old_pos = pos;
+                keys[idx] = extractor(proj(first[indices[idx]]), pos);
+                if (pos == old_pos) {
+                    pos = exhausted;
+                }
+            }
+
+            auto swap_entries(difference_type lhs, difference_type rhs)
+                -> void
+            {
+                using std::swap;
+                swap(keys[lhs], keys[rhs]);
+                swap(positions[lhs], positions[rhs]);
+                swap(indices[lhs], indices[rhs]);
+            }
+
+            // Compare the strings from the cached keys and positions
+            auto less(difference_type lhs, difference_type rhs) const
+                -> bool
+            {
+                if (keys[lhs] != keys[rhs]) {
+                    return keys[lhs] < keys[rhs];
+                }
+                if (positions[lhs] == exhausted) {
+                    // The end key is unique, both strings are equivalent
+                    return false;
+                }
+
+                auto&& proj = utility::as_function(projection);
+                auto&& lhs_str = proj(first[indices[lhs]]);
+                auto&& rhs_str = proj(first[indices[rhs]]);
+                auto lhs_pos = positions[lhs];
+                auto rhs_pos = positions[rhs];
+                while (true) {
+                    auto old_pos = lhs_pos;
+                    auto lhs_key = extractor(lhs_str, lhs_pos);
+                    auto rhs_key = extractor(rhs_str, rhs_pos);
+                    if (lhs_key != rhs_key) {
+                        return lhs_key < rhs_key;
+                    }
+                    if (lhs_pos == old_pos) {
+                        return false;
+                    }
+                }
+            }
+
+            auto insertion_sort(difference_type begin, difference_type end)
+                -> void
+            {
+                for (auto cur = begin + 1 ; cur < end ; ++cur) {
+                    for (auto sift = cur ; sift != begin && less(sift, sift - 1) ; --sift) {
+                        swap_entries(sift, sift - 1);
+                    }
+                }
+            }
+
+            auto median_of_3_key(difference_type begin, difference_type end) const
+                -> key_type
+            {
+                auto a = keys[begin];
+                auto b = keys[begin + (end - begin) / 2];
+                auto c = keys[end - 1];
+                if (b < a) {
+                    std::swap(a, b);
+                }
+                if (c < b) {
+                    b = (c < a) ? a : c;
+                }
+                return b;
+            }
+
+            auto sort(difference_type begin, difference_type end)
+                -> void
+            {
+                while (end - begin > insertion_limit) {
+                    // Three-way partition around the current keys
+                    auto pivot = median_of_3_key(begin, end);
+                    auto lt = begin;
+                    auto gt = end;
+                    for (auto it = begin ; it < gt ;) {
+                        if (keys[it] < pivot) {
+                            swap_entries(lt++, it++);
+                        } else if (pivot < keys[it]) {
+                            swap_entries(it, --gt);
+                        } else {
+                            ++it;
+                        }
+                    }
+
+                    // Strings equal to the pivot move on to the next
+                    // key, unless they were all fully examined
+                    auto eq_end = gt;
+                    if (positions[lt] == exhausted) {
+                        eq_end = lt;
+                    } else {
+                        for (auto it = lt ; it < gt ; ++it) {
+                            next_key(it);
+                        }
+                    }
+
+                    // Recurse into the two smallest partitions and
+                    // loop on the biggest one to bound the stack
+                    std::pair<difference_type, difference_type> parts[] = {
+                        { begin, lt }, { lt, eq_end }, { gt, end }
+                    };
+                    int biggest = 0;
+                    for (int idx = 1 ; idx < 3 ; ++idx) {
+                        if (parts[idx].second - parts[idx].first >
+                            parts[biggest].second - parts[biggest].first) {
+                            biggest = idx;
+                        }
+                    }
+                    for (int idx = 0 ; idx < 3 ; ++idx) {
+                        if (idx != biggest) {
+                            sort(parts[idx].first, parts[idx].second);
+                        }
+                    }
+                    begin = parts[biggest].first;
+                    end = parts[biggest].second;
+                }
+                insertion_sort(begin, end);
+            }
+    };
+
+    template<typename RandomAccessIterator, typename KeyExtractor, typename Projection>
+    auto multikey_quicksort(RandomAccessIterator first, RandomAccessIterator last,
+                            const KeyExtractor& extractor, Projection projection)
+        -> void
+    {
+        auto size = last - first;
+        if (size < 2) return;
+
+        multikey_quicksort_impl<RandomAccessIterator, KeyExtractor, Projection> sorter(
+            first, size, extractor, std::move(projection)
+        );
+        sorter.sort();
+    }
+}}
+
+#endif // CPPSORT_DETAIL_MULTIKEY_QUICKSORT_H_
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_PARALLEL_COUNT_INVERSIONS_H_
+#define CPPSORT_DETAIL_PARALLEL_COUNT_INVERSIONS_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include "count_inversions.h"
+#include "parallel_merge_tree.h"
+#include "parallel_multiway_merge.h"
+#include "thread_pool.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Parallel inversions counting
+    //
+    // Counts the inversions of an array of trivially copyable
+    // values, which are sorted along the way: the array is cut
+    // into one chunk per thread, and the inversions of every
+    // chunk are counted concurrently with the sequential merge
+    // sort based algorithm. The inversions between chunks are
+    // then counted while merging the chunks with a parallel
+    // merge tree, the output of every merge being cut into
+    // slices that are merged and counted concurrently.
+
+    namespace parallel_count_inversions_detail
+    {
+        enum {
+            // Below this size, the sequential algorithm is used
+            min_parallel_size = 1 << 15,
+
+            // Minimum number of elements handled by a single task
+            min_chunk_size = 1 << 13
+        };
+
+        // Merges [first1, last1) and [first2, last2) into result
+        // and returns the number of inversions between the elements
+        // of the two ranges; middle is the end of the left run, the
+        // elements of [last1, middle) all come after the elements
+        // of the right range in the merge
+        template<typename ResultType, typename T, typename Compare>
+        auto merge_count_slice(T* first1, T* last1, T* middle,
+                               T* first2, T* last2, T* result,
+                               Compare compare)
+            -> ResultType
+        {
+            auto&& comp = utility::as_function(compare);
+
+            ResultType inversions = 0;
+            while (first1 != last1 && first2 != last2) {
+                if (comp(*first2, *first1)) {
+                    inversions += middle - first1;
+                    *result++ = *first2++;
+                } else {
+                    *result++ = *first1++;
+                }
+            }
+            inversions += (last2 - first2) * (middle - first1);
+            result = std::copy(first1, last1, result);
+            std::copy(first2, last2, result);
+            return inversions;
+        }
+
+        template<typename ResultType, typename T, typename Compare>
+        auto merge_count(T* first, T* middle, T* last, T* buffer,
+                         std::size_t nb_tasks, Compare compare)
+            -> ResultType
+        {
+            auto size = last - first;
+            nb_tasks = (std::max)(
+                (std::min)(nb_tasks, static_cast<std::size_t>(size / min_chunk_size)),
+                std::size_t(1)
+            );
+            auto slice_bound = [&](std::size_t idx) {
+                return static_cast<std::ptrdiff_t>(size * idx / nb_tasks);
+            };
+
+            // Find the splitters of every output slice, the splitters
+            // of the slice idx being at splits[2 * idx]
+            const std::vector<T*> bounds = { first, middle, last };
+            std::vector<T*> splits(2 * (nb_tasks + 1));
+            splits[0] = first;
+            splits[1] = middle;
+            splits[2 * nb_tasks] = middle;
+            splits[2 * nb_tasks + 1] = last;
+            {
+                task_group group;
+                for (std::size_t idx = 1 ; idx < nb_tasks ; ++idx) {
+                    group.run([&, idx] {
+                        multiway_split(bounds, slice_bound(idx), splits.data() + 2 * idx,
+                                       compare, utility::identity{});
+                    });
+                }
+                group.wait();
+            }
+
+            // Merge and count the slices, then copy them back
+            std::vector<ResultType> inversions(nb_tasks, 0);
+            {
+                task_group group;
+                for (std::size_t idx = 0 ; idx < nb_tasks ; ++idx) {
+                    group.run([&, idx] {
+                        inversions[idx] = merge_count_slice<ResultType>(
+                            splits[2 * idx], splits[2 * idx + 2], middle,
+                            splits[2 * idx + 1], splits[2 * idx + 3],
+                            buffer + slice_bound(idx), compare
+                        );
+                    });
+                }
+                group.wait();
+            }
+            {
+                task_group group;
+                for (std::size_t idx = 0 ; idx < nb_tasks ; ++idx) {
+                    group.run([&, idx] {
+                        std::copy(buffer + slice_bound(idx), buffer + slice_bound(idx + 1),
+                                  first + slice_bound(idx));
+                    });
+                }
+                group.wait();
+            }
+
+            ResultType res = 0;
+            for (auto count: inversions) {
+                res += count;
+            }
+            return res;
+        }
+    }
+
+    // buffer must be able to hold last - first elements
+    template<typename ResultType, typename T, typename Compare>
+    auto parallel_count_inversions(T* first, T* last, T* buffer, Compare compare)
+        -> ResultType
+    {
+        using namespace parallel_count_inversions_detail;
+
+        auto size = last - first;
+        if (size < min_parallel_size || thread_pool::instance().concurrency() == 1) {
+            return count_inversions<ResultType>(first, last, buffer,
+                                                std::move(compare), utility::identity{});
+        }
+
+        // Count the inversions of one chunk per thread
+        auto nb_chunks = (std::min)(thread_pool::instance().concurrency(),
+                                    static_cast<std::size_t>(size / min_chunk_size));
+        std::vector<T*> bounds;
+        bounds.reserve(nb_chunks + 1);
+        for (std::size_t idx = 0 ; idx <= nb_chunks ; ++idx) {
+            bounds.push_back(first + static_cast<std::ptrdiff_t>(size * idx / nb_chunks));
+        }
+
+        std::vector<ResultType> chunk_inversions(nb_chunks, 0);
+        {
+            task_group group;
+            for (std::size_t idx = 0 ; idx < nb_chunks ; ++idx) {
+                group.run([&, idx] {
+                    chunk_inversions[idx] = count_inversions<ResultType>(
+                        bounds[idx], bounds[idx + 1], buffer + (bounds[idx] - first),
+                        compare, utility::identity{}
+                    );
+                });
+            }
+            group.wait();
+        }
+
+        // Count the inversions between chunks while merging them,
+        // the chunks that are already in order don't have any
+        std::atomic<ResultType> merge_inversions(0);
+        parallel_merge_tree(
+            bounds, compare, utility::identity{},
+            [&](T* begin, T* middle, T* end, std::size_t nb_tasks) {
+                merge_inversions.fetch_add(
+                    merge_count<ResultType>(begin, middle, end, buffer + (begin - first),
+                                            nb_tasks, compare),
+                    std::memory_order_relaxed
+                );
+            }
+        );
+
+        ResultType res = merge_inversions.load();
+        for (auto count: chunk_inversions) {
+            res += count;
+        }
+        return res;
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PARALLEL_COUNT_INVERSIONS_H_
@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_PARALLEL_COUNTING_SORT_H_
+#define CPPSORT_DETAIL_PARALLEL_COUNTING_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <vector>
+#include "counting_sort.h"
+#include "iterator_traits.h"
+#include "parallel_ska_sort.h"
+#include "reverse.h"
+#include "thread_pool.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Parallel counting sort
+    //
+    // The collection is cut into one chunk per thread, and every
+    // step of the counting sort is performed in parallel:
+    // - Every chunk computes its minimum, its maximum and whether
+    //   it is sorted in a single pass, the results are then
+    //   reduced to know the same about the whole collection.
+    // - Every chunk counts its values in its own array of counts,
+    //   then the arrays are summed pairwise in a tree reduction.
+    //   Every array covers the whole range of values, so fewer
+    //   chunks are used for this step when the range is wide, in
+    //   order to keep the total number of counts within a small
+    //   multiple of the size of the collection. When even two
+    //   arrays don't fit, a parallel radix sort is used instead.
+    // - The prefix sums of the counts give the position of every
+    //   value in the output, which is cut into slices that are
+    //   filled in parallel.
+
+    namespace parallel_counting_sort_detail
+    {
+        enum {
+            // Below this size, the sequential algorithm is used
+            min_parallel_size = 1 << 16,
+
+            // Minimum number of elements handled by a single task
+            min_chunk_size = 1 << 15,
+
+            // Maximum number of counts for all the chunks, as a
+            // multiple of the number of elements to sort
+            max_counts_factor = 2
+        };
+
+        template<typename Iterator>
+        struct chunk_info
+        {
+            Iterator min;
+            Iterator max;
+            bool is_sorted;
+        };
+
+        // Counts the values of [first, last), counts is indexed from
+        // min for an ascending sort and from max for a descending one
+        template<typename Compare, typename RandomAccessIterator, typename T>
+        auto count_values(RandomAccessIterator first, RandomAccessIterator last,
+                          std::vector<difference_type_t<RandomAccessIterator>>& counts,
+                          T min, T max)
+            -> void
+        {
+            for (auto it = first; it != last; ++it) {
+                if (std::is_same<Compare, std::less<>>::value) {
+                    ++counts[*it - min];
+                } else {
+                    ++counts[max - *it];
+                }
+            }
+        }
+
+        template<typename Compare, typename RandomAccessIterator>
+        auto parallel_counting_sort(RandomAccessIterator first, RandomAccessIterator last)
+            -> void
+        {
+            using difference_type = difference_type_t<RandomAccessIterator>;
+            using iterator_info = chunk_info<RandomAccessIterator>;
+            Compare compare;
+
+            auto size = last - first;
+            std::size_t nb_chunks = (std::min)(
+                thread_pool::instance().concurrency(),
+                static_cast<std::size_t>(size / min_chunk_size)
+            );
+            if (size < min_parallel_size || nb_chunks < 2) {
+                if (std::is_same<Compare, std::less<>>::value) {
+                    counting_sort(std::move(first), std::move(last));
+                } else {
+                    reverse_counting_sort(std::move(first), std::move(last));
+                }
+                return;
+            }
+            auto chunk_bound = [&](std::size_t idx) {
+                return first + static_cast<difference_type>(size * idx / nb_chunks);
+            };
+
+            // Fused minmax & is_sorted pass over every chunk
+            std::vector<iterator_info> infos(nb_chunks);
+            {
+                task_group group;
+                for (std::size_t idx = 0; idx < nb_chunks; ++idx) {
+                    group.run([&, idx] {
+                        auto chunk_first = chunk_bound(idx);
+                        auto chunk_last = chunk_bound(idx + 1);
+                        iterator_info info = { chunk_first, chunk_first, true };
+                        for (auto it = std::next(chunk_first); it != chunk_last; ++it) {
+                            if (*it < *info.min) {
+                                info.min = it;
+                            } else if (not (*it < *info.max)) {
+                                info.max = it;
+                            }
+                            if (compare(*it, *std::prev(it))) {
+                                info.is_sorted = false;
+                            }
+                        }
+                        infos[idx] = info;
+                    });
+                }
+                group.wait();
+            }
+
+            iterator_info info = infos[0];
+            for (std::size_t idx = 1; idx < nb_chunks; ++idx) {
+                const auto& chunk = infos[idx];
+                if (*chunk.min < *info.min) {
+                    info.min = chunk.min;
+                }
+                if (not (*chunk.max < *info.max)) {
+                    info.max = chunk.max;
+                }
+                // The boundary between two chunks must be sorted too
+                auto chunk_first = chunk_bound(idx);
+                info.is_sorted = info.is_sorted && chunk.is_sorted
+                              && not compare(*chunk_first, *std::prev(chunk_first));
+            }
+            if (info.is_sorted) return;
+
+            auto min = *info.min;
+            auto max = *info.max;
+            // Number of chunks whose counts fit in the memory budget,
+            // computed in floating point since max - min can overflow
+            auto nb_count_chunks = static_cast<std::size_t>((std::min)(
+                static_cast<double>(nb_chunks),
+                max_counts_factor * static_cast<double>(size)
+                    / (static_cast<double>(max) - static_cast<double>(min) + 1.0)
+            ));
+            if (nb_count_chunks < 2 ||
+                counting_sort_detail::is_sparse_range(min, max, static_cast<std::size_t>(size))) {
+                // Parallel radix sort which doesn't depend on the range
+                // of values, same as the sequential algorithm
+                parallel_ska_sort(first, last, counting_sort_detail::as_ordered_integer{});
+                if (not std::is_same<Compare, std::less<>>::value) {
+                    detail::reverse(first, last);
+                }
+                return;
+            }
+            difference_type value_range = max - min + 1;
+
+            // Count the values of every chunk in its own array
+            auto count_bound = [&](std::size_t idx) {
+                return first + static_cast<difference_type>(size * idx / nb_count_chunks);
+            };
+            std::vector<std::vector<difference_type>> counts(nb_count_chunks);
+            {
+                task_group group;
+                for (std::size_t idx = 0; idx < nb_count_chunks; ++idx) {
+                    group.run([&, idx] {
+                        counts[idx].assign(value_range, 0);
+                        count_values<Compare>(count_bound(idx), count_bound(idx + 1),
+                                              counts[idx], min, max);
+                    });
+                }
+                group.wait();
+            }
+
+            // Tree reduction of the counts into counts[0]
+            for (std::size_t step = 1; step < nb_count_chunks; step *= 2) {
+                task_group group;
+                for (std::size_t idx = 0; idx + step < nb_count_chunks; idx += 2 * step) {
+                    group.run([&, idx, step] {
+                        std::transform(counts[idx].begin(), counts[idx].end(),
+                                       counts[idx + step].begin(), counts[idx].begin(),
+                                       std::plus<>{});
+                        std::vector<difference_type>().swap(counts[idx + step]);
+                    });
+                }
+                group.wait();
+            }
+
+            // Turn the counts into the end positions of every value in
+            // the output, then fill slices of the output in parallel
+            auto& positions = counts[0];
+            std::partial_sum(positions.begin(), positions.end(), positions.begin());
+            {
+                task_group group;
+                for (std::size_t idx = 0; idx < nb_chunks; ++idx) {
+                    group.run([&, idx] {
+                        auto slice_first = chunk_bound(idx) - first;
+                        auto slice_last = chunk_bound(idx + 1) - first;
+                        // Index of the value at the beginning of the slice
+                        auto pos_it = std::upper_bound(positions.begin(), positions.end(), slice_first);
+                        auto out = first + slice_first;
+                        while (slice_first != slice_last) {
+                            auto value_idx = pos_it - positions.begin();
+                            auto value = std::is_same<Compare, std::less<>>::value ?
+                                static_cast<decltype(min)>(min + value_idx) :
+                                static_cast<decltype(min)>(max - value_idx);
+                            auto count = (std::min)(*pos_it, slice_last) - slice_first;
+                            out = std::fill_n(out, count, value);
+                            slice_first += count;
+                            ++pos_it;
+                        }
+                    });
+                }
+                group.wait();
+            }
+        }
+    }
+
+    template<typename RandomAccessIterator>
+    auto parallel_counting_sort(RandomAccessIterator first, RandomAccessIterator last)
+        -> void
+    {
+        parallel_counting_sort_detail::parallel_counting_sort<std::less<>>(
+            std::move(first), std::move(last)
+        );
+    }
+
+    template<typename RandomAccessIterator>
+    auto reverse_parallel_counting_sort(RandomAccessIterator first, RandomAccessIterator last)
+        -> void
+    {
+        parallel_counting_sort_detail::parallel_counting_sort<std::greater<>>(
+            std::move(first), std::move(last)
+        );
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PARALLEL_COUNTING_SORT_H_
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_PARALLEL_GRAILSORT_H_
+#define CPPSORT_DETAIL_PARALLEL_GRAILSORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <utility>
+#include "grail_sort.h"
+#include "parallel_symmerge.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Parallel grailsort
+    //
+    // The block merges performed by grailsort all rely on the same
+    // internal buffer and keys, both of which move along the
+    // collection during a merge pass, which prevents them from
+    // running concurrently: chunks of the collection are sorted
+    // with grailsort, each of them extracting its own buffer and
+    // keys, then merged with parallel symmerges.
+
+    template<typename BufferProvider, typename RandomAccessIterator,
+             typename Compare, typename Projection>
+    auto parallel_grailsort(RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare, Projection projection)
+        -> void
+    {
+        parallel_chunk_sort_then_symmerge<BufferProvider>(
+            std::move(first), std::move(last),
+            std::move(compare), std::move(projection),
+            [](RandomAccessIterator chunk_first, RandomAccessIterator chunk_last,
+               Compare chunk_compare, Projection chunk_projection) {
+                grail::grail_sort<BufferProvider>(std::move(chunk_first), std::move(chunk_last),
+                                                  std::move(chunk_compare), std::move(chunk_projection));
+            }
+        );
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PARALLEL_GRAILSORT_H_
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_PARALLEL_MERGE_TREE_H_
+#define CPPSORT_DETAIL_PARALLEL_MERGE_TREE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+#include <cpp-sort/utility/as_function.h>
+#include "iterator_traits.h"
+#include "memory.h"
+#include "parallel_multiway_merge.h"
+#include "thread_pool.h"
+#include "timsort.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Parallel merge tree
+    //
+    // Merges consecutive sorted runs whose bounds are given by
+    // bounds, which is updated along the way. Consecutive runs
+    // that are already in order are first coalesced into a single
+    // run, then the remaining runs are merged pairwise level by
+    // level: the merges of a given level are independent and run
+    // concurrently. Every merge first skips the elements that are
+    // already in place with galloping searches, then the remaining
+    // elements are merged with TimSort's merge, or with a parallel
+    // merge when few big merges are left to perform. The merges
+    // are stable. Another merge algorithm can be provided, it is
+    // then called with the bounds of the runs to merge and with
+    // the number of threads it is allowed to use.
+
+    namespace parallel_merge_tree_detail
+    {
+        enum {
+            // Minimum number of elements merged by a single task
+            min_chunk_size = 1 << 13,
+
+            // Minimum number of elements to merge in parallel
+            min_parallel_merge_size = 1 << 15
+        };
+
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto merge_runs(RandomAccessIterator first, RandomAccessIterator middle,
+                        RandomAccessIterator last, std::size_t nb_tasks,
+                        Compare compare, Projection projection)
+            -> void
+        {
+            using timsort_type = TimSort<RandomAccessIterator, Compare, Projection>;
+            using rvalue_type = rvalue_type_t<RandomAccessIterator>;
+            auto&& proj = utility::as_function(projection);
+
+            // Elements of the first run that are smaller than the first
+            // element of the second run are already in place
+            first += timsort_type::gallopRight(proj(*middle), first, middle - first, 0,
+                                               compare, projection);
+            if (first == middle) return;
+
+            // Same for the elements of the second run that are greater
+            // than the last element of the first run
+            auto len2 = last - middle;
+            last = middle + timsort_type::gallopLeft(proj(*std::prev(middle)), middle, len2, len2 - 1,
+                                                     compare, projection);
+            if (last == middle) return;
+
+            auto size = last - first;
+            if (nb_tasks > 1 && size >= min_parallel_merge_size) {
+                std::unique_ptr<rvalue_type, operator_deleter> buffer(
+                    static_cast<rvalue_type*>(::operator new(size * sizeof(rvalue_type), std::nothrow)),
+                    operator_deleter(size * sizeof(rvalue_type))
+                );
+                if (buffer != nullptr) {
+                    std::vector<RandomAccessIterator> bounds = { first, middle, last };
+                    parallel_multiway_merge(bounds, buffer.get(),
+                                            (std::min)(nb_tasks, static_cast<std::size_t>(size / min_chunk_size)),
+                                            std::move(compare), std::move(projection));
+                    return;
+                }
+            }
+
+            timsort_type ts{};
+            ts.mergeConsecutiveRuns(first, middle - first, middle, last - middle,
+                                    std::move(compare), std::move(projection));
+        }
+    }
+
+    template<typename RandomAccessIterator, typename Compare,
+             typename Projection, typename Merge>
+    auto parallel_merge_tree(std::vector<RandomAccessIterator>& bounds,
+                             Compare compare, Projection projection, Merge merge)
+        -> void
+    {
+        auto&& comp = utility::as_function(compare);
+        auto&& proj = utility::as_function(projection);
+
+        if (bounds.size() < 3) return;
+
+        // Coalesce the consecutive runs that are already in order,
+        // which is common when the collection is mostly sorted
+        bounds.erase(
+            std::remove_if(bounds.begin() + 1, bounds.end() - 1, [&](RandomAccessIterator it) {
+                return not comp(proj(*it), proj(*std::prev(it)));
+            }),
+            bounds.end() - 1
+        );
+
+        // Merge the runs pairwise, the merges of a level running concurrently
+        auto concurrency = thread_pool::instance().concurrency();
+        while (bounds.size() > 2) {
+            std::size_t nb_runs = bounds.size() - 1;
+            std::size_t nb_merges = nb_runs / 2;
+            // Threads left idle by a level with few merges are used
+            // to perform the merges themselves in parallel
+            std::size_t nb_tasks = (std::max)(concurrency / nb_merges, std::size_t(1));
+
+            {
+                task_group group;
+                for (std::size_t idx = 0 ; idx < nb_merges ; ++idx) {
+                    group.run([&, idx, nb_tasks] {
+                        merge(bounds[2 * idx], bounds[2 * idx + 1], bounds[2 * idx + 2],
+                              nb_tasks);
+                    });
+                }
+                group.wait();
+            }
+
+            // Keep the bounds of the merged runs, and of the last run
+            // when there is an odd number of runs
+            std::size_t out = 1;
+            for (std::size_t idx = 2 ; idx < bounds.size() ; idx += 2) {
+                bounds[out++] = bounds[idx];
+            }
+            if (nb_runs % 2 != 0) {
+                bounds[out++] = bounds.back();
+            }
+            bounds.resize(out);
+        }
+    }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto parallel_merge_tree(std::vector<RandomAccessIterator>& bounds,
+                             Compare compare, Projection projection)
+        -> void
+    {
+        parallel_merge_tree(
+            bounds, compare, projection,
+            [&](RandomAccessIterator first, RandomAccessIterator middle,
+                RandomAccessIterator last, std::size_t nb_tasks) {
+                parallel_merge_tree_detail::merge_runs(first, middle, last, nb_tasks,
+                                                       compare, projection);
+            }
+        );
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PARALLEL_MERGE_TREE_H_
@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_PARALLEL_MULTIWAY_MERGE_H_
+#define CPPSORT_DETAIL_PARALLEL_MULTIWAY_MERGE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/iter_move.h>
+#include "config.h"
+#include "iterator_traits.h"
+#include "lower_bound.h"
+#include "memory.h"
+#include "move.h"
+#include "scope_exit.h"
+#include "thread_pool.h"
+#include "upper_bound.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Multiway selection
+    //
+    // Given consecutive sorted runs [bounds[i], bounds[i + 1]),
+    // finds for every run the position splits[i] such that the
+    // elements before the splits are exactly the rank first
+    // elements of the stable merge of the runs, where equivalent
+    // elements are ordered by run first. The rank-th element of
+    // the merge is found by binary searching every run, the rank
+    // of a candidate being computed with binary searches in all
+    // the other runs, hence a O(k² log² n) complexity for k runs.
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto multiway_split(const std::vector<RandomAccessIterator>& bounds,
+                        difference_type_t<RandomAccessIterator> rank,
+                        RandomAccessIterator* splits,
+                        Compare compare, Projection projection)
+        -> void
+    {
+        using difference_type = difference_type_t<RandomAccessIterator>;
+        auto&& proj = utility::as_function(projection);
+        std::size_t nb_runs = bounds.size() - 1;
+
+        if (rank == bounds.back() - bounds.front()) {
+            std::copy(bounds.begin() + 1, bounds.end(), splits);
+            return;
+        }
+
+        // Computes the splits around the value of an element of the run idx: it
+        // comes after the equivalent elements of the previous runs, and before
+        // those of the next runs
+        auto split_around = [&](std::size_t idx, RandomAccessIterator it) {
+            auto&& value = proj(*it);
+            for (std::size_t i = 0 ; i < idx ; ++i) {
+                splits[i] = detail::upper_bound(bounds[i], bounds[i + 1], value, compare, projection);
+            }
+            splits[idx] = it;
+            for (std::size_t i = idx + 1 ; i < nb_runs ; ++i) {
+                splits[i] = detail::lower_bound(bounds[i], bounds[i + 1], value, compare, projection);
+            }
+        };
+
+        // The rank-th element of the merge is in exactly one of the runs
+        for (std::size_t idx = 0 ; idx < nb_runs ; ++idx) {
+            auto lo = bounds[idx];
+            auto hi = bounds[idx + 1];
+            while (lo != hi) {
+                auto mid = lo + (hi - lo) / 2;
+                split_around(idx, mid);
+                difference_type before = 0;
+                for (std::size_t i = 0 ; i < nb_runs ; ++i) {
+                    before += splits[i] - bounds[i];
+                }
+
+                if (before == rank) {
+                    return;
+                }
+                if (before < rank) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+        }
+        CPPSORT_UNREACHABLE;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Sequential multiway merge
+    //
+    // Merges the sorted runs [runs[i].first, runs[i].second)
+    // into the uninitialized memory starting at result, taking
+    // the equivalent elements from the first runs first, and
+    // returns the end of the constructed elements. A binary heap
+    // of runs is used to pick the next element to move.
+
+    template<typename RandomAccessIterator, typename T, typename Compare, typename Projection>
+    auto multiway_merge_construct(std::vector<std::pair<RandomAccessIterator, RandomAccessIterator>>& runs,
+                                  T* result, destruct_n<T>& destroyer,
+                                  Compare compare, Projection projection)
+        -> T*
+    {
+        using utility::iter_move;
+        auto&& comp = utility::as_function(compare);
+        auto&& proj = utility::as_function(projection);
+
+        std::vector<std::size_t> heap;
+        heap.reserve(runs.size());
+        for (std::size_t idx = 0 ; idx < runs.size() ; ++idx) {
+            if (runs[idx].first != runs[idx].second) {
+                heap.push_back(idx);
+            }
+        }
+
+        // Ordering for a max-heap whose top is the run holding the
+        // smallest current element
+        auto heap_compare = [&](std::size_t lhs, std::size_t rhs) {
+            auto&& lhs_proj = proj(*runs[lhs].first);
+            auto&& rhs_proj = proj(*runs[rhs].first);
+            if (comp(rhs_proj, lhs_proj)) return true;
+            if (comp(lhs_proj, rhs_proj)) return false;
+            return rhs < lhs;
+        };
+        std::make_heap(heap.begin(), heap.end(), heap_compare);
+
+        while (heap.size() > 1) {
+            std::pop_heap(heap.begin(), heap.end(), heap_compare);
+            auto& run = runs[heap.back()];
+            ::new(result) T(iter_move(run.first));
+            ++result;
+            ++destroyer;
+            if (++run.first == run.second) {
+                heap.pop_back();
+            } else {
+                std::push_heap(heap.begin(), heap.end(), heap_compare);
+            }
+        }
+
+        if (not heap.empty()) {
+            auto& run = runs[heap.front()];
+            result = detail::uninitialized_move(run.first, run.second, result, destroyer);
+            run.first = run.second;
+        }
+        return result;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Parallel multiway merge
+    //
+    // Stable merge of the consecutive sorted runs delimited by
+    // bounds. The output is cut into nb_tasks slices of similar
+    // sizes whose splitters are found with a multiway selection
+    // in every run, which makes every slice an independent
+    // multiway merge writing to a disjoint part of buffer. The
+    // merged elements are then moved back to the original range.
+    // buffer must be able to hold bounds.back() - bounds.front()
+    // elements.
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto parallel_multiway_merge(const std::vector<RandomAccessIterator>& bounds,
+                                 rvalue_type_t<RandomAccessIterator>* buffer,
+                                 std::size_t nb_tasks,
+                                 Compare compare, Projection projection)
+        -> void
+    {
+        using difference_type = difference_type_t<RandomAccessIterator>;
+        using rvalue_type = rvalue_type_t<RandomAccessIterator>;
+
+        std::size_t nb_runs = bounds.size() - 1;
+        if (nb_runs < 2) return;
+
+        auto first = bounds.front();
+        difference_type size = bounds.back() - first;
+        auto slice_bound = [&](std::size_t idx) {
+            return static_cast<difference_type>(size * idx / nb_tasks);
+        };
+
+        // Find the splitters of every output slice, the splitters of
+        // the slice idx being the run positions at splits[idx * nb_runs]
+        std::vector<RandomAccessIterator> splits((nb_tasks + 1) * nb_runs);
+        std::copy(bounds.begin(), bounds.end() - 1, splits.begin());
+        std::copy(bounds.begin() + 1, bounds.end(), splits.begin() + nb_tasks * nb_runs);
+        {
+            task_group group;
+            for (std::size_t idx = 1 ; idx < nb_tasks ; ++idx) {
+                group.run([&, idx] {
+                    multiway_split(bounds, slice_bound(idx), splits.data() + idx * nb_runs,
+                                   compare, projection);
+                });
+            }
+            group.wait();
+        }
+
+        // Merge the slices into the buffer, keeping track of the fully
+        // constructed slices to destroy them if anything goes wrong
+        std::vector<char> merged(nb_tasks, false);
+        auto destroy_merged = make_scope_exit([&] {
+            for (std::size_t idx = 0 ; idx < nb_tasks ; ++idx) {
+                if (merged[idx]) {
+                    detail::destroy(buffer + slice_bound(idx), buffer + slice_bound(idx + 1));
+                }
+            }
+        });
+        {
+            task_group group;
+            for (std::size_t idx = 0 ; idx < nb_tasks ; ++idx) {
+                group.run([&, idx] {
+                    std::vector<std::pair<RandomAccessIterator, RandomAccessIterator>> runs;
+                    runs.reserve(nb_runs);
+                    for (std::size_t i = 0 ; i < nb_runs ; ++i) {
+                        runs.emplace_back(splits[idx * nb_runs + i], splits[(idx + 1) * nb_runs + i]);
+                    }
+
+                    destruct_n<rvalue_type> d(0);
+                    std::unique_ptr<rvalue_type, destruct_n<rvalue_type>&> h(buffer + slice_bound(idx), d);
+                    multiway_merge_construct(runs, buffer + slice_bound(idx), d, compare, projection);
+                    h.release();
+                    merged[idx] = true;
+                });
+            }
+            group.wait();
+        }
+
+        // Move the merged elements back to the original collection
+        task_group group;
+        for (std::size_t idx = 0 ; idx < nb_tasks ; ++idx) {
+            group.run([&, idx] {
+                detail::move(buffer + slice_bound(idx), buffer + slice_bound(idx + 1),
+                             first + slice_bound(idx));
+            });
+        }
+        group.wait();
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PARALLEL_MULTIWAY_MERGE_H_
@@ -0,0 +1,329 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_PARALLEL_PDQSORT_H_
+#define CPPSORT_DETAIL_PARALLEL_PDQSORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/branchless_traits.h>
+#include <cpp-sort/utility/iter_move.h>
+#include "bitops.h"
+#include "heapsort.h"
+#include "iterator_traits.h"
+#include "iter_sort3.h"
+#include "pdqsort.h"
+#include "thread_pool.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    namespace pdqsort_detail
+    {
+        enum {
+            // Partitions below this size are sorted sequentially.
+            sequential_threshold = 2048,
+
+            // Partitions above this size are partitioned in parallel.
+            parallel_partition_threshold = 1 << 16,
+
+            // Minimum number of elements partitioned by a single task.
+            parallel_partition_chunk_size = 1 << 14
+        };
+
+        // Partitions [first, last) so that the elements smaller than the pivot come first, returns
+        // the partition point and whether elements had to be swapped.
+        template<typename RandomAccessIterator, typename Compare, typename Projection, typename T>
+        auto partition_chunk(RandomAccessIterator first, RandomAccessIterator last,
+                             Compare compare, Projection projection, T& pivot_proj)
+            -> std::pair<RandomAccessIterator, bool>
+        {
+            using utility::iter_swap;
+            auto&& comp = utility::as_function(compare);
+            auto&& proj = utility::as_function(projection);
+
+            bool swapped = false;
+            while (true) {
+                while (true) {
+                    if (first == last) return std::make_pair(first, swapped);
+                    if (not comp(proj(*first), pivot_proj)) break;
+                    ++first;
+                }
+                --last;
+                while (true) {
+                    if (first == last) return std::make_pair(first, swapped);
+                    if (comp(proj(*last), pivot_proj)) break;
+                    --last;
+                }
+                iter_swap(first, last);
+                swapped = true;
+                ++first;
+            }
+        }
+
+        // Same contract as partition_right, except that [begin, end) is split into chunks that are
+        // partitioned in parallel, then the elements on the wrong side of the global partition point
+        // are swapped in parallel too.
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto parallel_partition_right(RandomAccessIterator begin, RandomAccessIterator end,
+                                      Compare compare, Projection projection, std::size_t concurrency)
+            -> std::pair<RandomAccessIterator, bool>
+        {
+            using utility::iter_move;
+            using utility::iter_swap;
+            using difference_type = difference_type_t<RandomAccessIterator>;
+            auto&& proj = utility::as_function(projection);
+
+            // Move pivot into local for speed.
+            auto pivot = iter_move(begin);
+            auto&& pivot_proj = proj(pivot);
+
+            RandomAccessIterator first = begin + 1;
+            difference_type size = end - first;
+            std::size_t nb_chunks = (std::min)(concurrency,
+                                               static_cast<std::size_t>(size / parallel_partition_chunk_size));
+
+            std::vector<RandomAccessIterator> bounds;
+            std::vector<RandomAccessIterator> mids(nb_chunks);
+            std::vector<char> swapped(nb_chunks);
+            bounds.reserve(nb_chunks + 1);
+            for (std::size_t i = 0 ; i <= nb_chunks ; ++i) {
+                bounds.push_back(first + static_cast<difference_type>(size * i / nb_chunks));
+            }
+
+            // Partition every chunk independently.
+            {
+                task_group group;
+                for (std::size_t i = 0 ; i < nb_chunks ; ++i) {
+                    group.run([&, i] {
+                        auto res = partition_chunk(bounds[i], bounds[i + 1], compare, projection, pivot_proj);
+                        mids[i] = res.first;
+                        swapped[i] = res.second;
+                    });
+                }
+                group.wait();
+            }
+
+            // Compute the global partition point and the intervals of elements that lie on the wrong
+            // side of it: there are as many misplaced elements on each side.
+            RandomAccessIterator mid = first;
+            for (std::size_t i = 0 ; i < nb_chunks ; ++i) {
+                mid += mids[i] - bounds[i];
+            }
+
+            std::vector<std::pair<RandomAccessIterator, RandomAccessIterator>> misplaced_l, misplaced_r;
+            difference_type nb_misplaced = 0;
+            for (std::size_t i = 0 ; i < nb_chunks ; ++i) {
+                // Elements not smaller than the pivot before the partition point
+                auto l_first = mids[i];
+                auto l_last = (std::min)(bounds[i + 1], mid);
+                if (l_first < l_last) {
+                    misplaced_l.emplace_back(l_first, l_last);
+                    nb_misplaced += l_last - l_first;
+                }
+                // Elements smaller than the pivot after the partition point
+                auto r_first = (std::max)(bounds[i], mid);
+                auto r_last = mids[i];
+                if (r_first < r_last) {
+                    misplaced_r.emplace_back(r_first, r_last);
+                }
+            }
+
+            bool already_partitioned = nb_misplaced == 0 &&
+                std::find(swapped.begin(), swapped.end(), true) == swapped.end();
+
+            if (nb_misplaced > 0) {
+                // Swaps the count misplaced elements starting at the given offset in the
+                // concatenation of the intervals of misplaced elements on each side.
+                auto swap_misplaced = [&](difference_type offset, difference_type count) {
+                    auto it_l = misplaced_l.begin();
+                    auto it_r = misplaced_r.begin();
+                    auto offset_l = offset;
+                    while (offset_l >= it_l->second - it_l->first) {
+                        offset_l -= it_l->second - it_l->first;
+                        ++it_l;
+                    }
+                    auto offset_r = offset;
+                    while (offset_r >= it_r->second - it_r->first) {
+                        offset_r -= it_r->second - it_r->first;
+                        ++it_r;
+                    }
+
+                    auto l = it_l->first + offset_l;
+                    auto r = it_r->first + offset_r;
+                    while (true) {
+                        iter_swap(l, r);
+                        if (--count == 0) break;
+                        if (++l == it_l->second) l = (++it_l)->first;
+                        if (++r == it_r->second) r = (++it_r)->first;
+                    }
+                };
+
+                std::size_t nb_tasks = (std::min)(nb_chunks,
+                    static_cast<std::size_t>(nb_misplaced / parallel_partition_chunk_size) + 1);
+                task_group group;
+                for (std::size_t i = 0 ; i < nb_tasks ; ++i) {
+                    auto task_first = static_cast<difference_type>(nb_misplaced * i / nb_tasks);
+                    auto task_last = static_cast<difference_type>(nb_misplaced * (i + 1) / nb_tasks);
+                    group.run([&, task_first, task_last] {
+                        swap_misplaced(task_first, task_last - task_first);
+                    });
+                }
+                group.wait();
+            }
+
+            // Put the pivot in the right place.
+            auto pivot_pos = mid - 1;
+            *begin = iter_move(pivot_pos);
+            *pivot_pos = std::move(pivot);
+
+            return std::make_pair(pivot_pos, already_partitioned);
+        }
+
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto parallel_pdqsort_loop(task_group& group,
+                                   RandomAccessIterator begin, RandomAccessIterator end,
+                                   Compare compare, Projection projection,
+                                   int bad_allowed, bool leftmost=true)
+            -> void
+        {
+            using utility::iter_swap;
+            using difference_type = difference_type_t<RandomAccessIterator>;
+            using value_type = value_type_t<RandomAccessIterator>;
+            using projected_type = projected_t<RandomAccessIterator, Projection>;
+
+            constexpr bool is_branchless =
+                utility::is_probably_branchless_comparison_v<Compare, projected_type> &&
+                utility::is_probably_branchless_projection_v<Projection, value_type>;
+            (void)is_branchless; // Silence a -Wunused-but-set-variable false positive
+
+            auto&& comp = utility::as_function(compare);
+            auto&& proj = utility::as_function(projection);
+
+            while (true) {
+                difference_type size = end - begin;
+
+                // Small partitions are not worth the synchronization costs.
+                if (size < sequential_threshold) {
+                    pdqsort_loop(std::move(begin), std::move(end),
+                                 std::move(compare), std::move(projection),
+                                 bad_allowed, leftmost);
+                    return;
+                }
+
+                // Choose pivot as pseudomedian of 9.
+                difference_type s2 = size / 2;
+                iter_sort3(begin, begin + s2, end - 1, compare, projection);
+                iter_sort3(begin + 1, begin + (s2 - 1), end - 2, compare, projection);
+                iter_sort3(begin + 2, begin + (s2 + 1), end - 3, compare, projection);
+                iter_sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), compare, projection);
+                iter_swap(begin, begin + s2);
+
+                // See pdqsort_loop: elements equal to *(begin - 1) are put in the left partition,
+                // which is then already sorted.
+                if (!leftmost && !comp(proj(*(begin - 1)), proj(*begin))) {
+                    begin = partition_left(begin, end, compare, projection) + 1;
+                    continue;
+                }
+
+                // Partition and get results.
+                std::pair<RandomAccessIterator, bool> part_result =
+                    (size >= parallel_partition_threshold && group.concurrency() > 1) ?
+                        parallel_partition_right(begin, end, compare, projection, group.concurrency()) :
+                    is_branchless ?
+                        partition_right_branchless(begin, end, compare, projection) :
+                        partition_right(begin, end, compare, projection);
+                RandomAccessIterator pivot_pos = part_result.first;
+                bool already_partitioned = part_result.second;
+
+                // Check for a highly unbalanced partition.
+                difference_type l_size = pivot_pos - begin;
+                difference_type r_size = end - (pivot_pos + 1);
+                bool highly_unbalanced = l_size < size / 8 || r_size < size / 8;
+
+                // If we got a highly unbalanced partition we shuffle elements to break many patterns.
+                if (highly_unbalanced) {
+                    // If we had too many bad partitions, switch to heapsort to guarantee O(n log n).
+                    if (--bad_allowed == 0) {
+                        heapsort(std::move(begin), std::move(end),
+                                 std::move(compare), std::move(projection));
+                        return;
+                    }
+
+                    if (l_size >= insertion_sort_threshold) {
+                        iter_swap(begin,             begin + l_size / 4);
+                        iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+
+                        if (l_size > ninther_threshold) {
+                            iter_swap(begin + 1,         begin + (l_size / 4 + 1));
+                            iter_swap(begin + 2,         begin + (l_size / 4 + 2));
+                            iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                            iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+                        }
+                    }
+
+                    if (r_size >= insertion_sort_threshold) {
+                        iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                        iter_swap(end - 1,                   end - r_size / 4);
+
+                        if (r_size > ninther_threshold) {
+                            iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                            iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                            iter_swap(end - 2,             end - (1 + r_size / 4));
+                            iter_swap(end - 3,             end - (2 + r_size / 4));
+                        }
+                    }
+                } else {
+                    // If we were decently balanced and we tried to sort an already partitioned
+                    // sequence try to use insertion sort.
+                    if (already_partitioned &&
+                        partial_insertion_sort(begin, pivot_pos, compare, projection) &&
+                        partial_insertion_sort(pivot_pos + 1, end, compare, projection)) {
+                        return;
+                    }
+                }
+
+                // Sort the left partition in a new task, which can be stolen by another thread, and
+                // keep working on the right-hand partition. Both partitions only read the pivot,
+                // which is already in its final position.
+                group.run([=, &group] {
+                    parallel_pdqsort_loop(group, begin, pivot_pos, compare, projection,
+                                          bad_allowed, leftmost);
+                });
+                begin = pivot_pos + 1;
+                leftmost = false;
+            }
+        }
+    }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto parallel_pdqsort(RandomAccessIterator begin, RandomAccessIterator end,
+                          Compare compare, Projection projection)
+        -> void
+    {
+        auto size = end - begin;
+        if (size < pdqsort_detail::sequential_threshold) {
+            // Don't even start the thread pool for small collections
+            pdqsort(std::move(begin), std::move(end),
+                    std::move(compare), std::move(projection));
+            return;
+        }
+
+        task_group group;
+        pdqsort_detail::parallel_pdqsort_loop(group, std::move(begin), std::move(end),
+                                              std::move(compare), std::move(projection),
+                                              detail::log2(size));
+        group.wait();
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PARALLEL_PDQSORT_H_
@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_PARALLEL_SKA_SORT_H_
+#define CPPSORT_DETAIL_PARALLEL_SKA_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/iter_move.h>
+#include "iterator_traits.h"
+#include "memory.h"
+#include "move.h"
+#include "ska_sort.h"
+#include "thread_pool.h"
+#include "type_traits.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Parallel ska_sort
+    //
+    // The most significant bytes of the first sub-key of the
+    // elements are handled by parallel out-of-place passes: the
+    // collection is cut into one chunk per thread, every thread
+    // computes the histogram of its chunk, and then scatters its
+    // elements to a buffer at offsets computed from the prefix
+    // sums of all histograms, before the buckets are moved back
+    // to the collection. Every bucket is then sorted in its own
+    // task, either with another parallel pass if it is still
+    // big enough, or with the sequential in-place algorithm.
+
+    namespace parallel_ska_sort_detail
+    {
+        enum {
+            // Below this size, buckets are sorted sequentially.
+            min_parallel_size = 1 << 16,
+
+            // Minimum number of elements counted and scattered by
+            // a single task during a parallel pass.
+            min_chunk_size = 1 << 14,
+
+            // Same thresholds as the sequential ska_sort.
+            std_sort_threshold = 128,
+            american_flag_sort_threshold = 1024
+        };
+
+        // Number of bytes of a sub-key that can be handled by
+        // the parallel passes, 0 if it isn't an unsigned integer
+        template<typename SubKeyType>
+        struct radix_bytes:
+            std::integral_constant<std::size_t, 0>
+        {};
+
+        template<>
+        struct radix_bytes<std::uint8_t>:
+            std::integral_constant<std::size_t, 1>
+        {};
+
+        template<>
+        struct radix_bytes<std::uint16_t>:
+            std::integral_constant<std::size_t, 2>
+        {};
+
+        template<>
+        struct radix_bytes<std::uint32_t>:
+            std::integral_constant<std::size_t, 4>
+        {};
+
+        template<>
+        struct radix_bytes<std::uint64_t>:
+            std::integral_constant<std::size_t, 8>
+        {};
+
+#ifdef __SIZEOF_INT128__
+        template<>
+        struct radix_bytes<__uint128_t>:
+            std::integral_constant<std::size_t, 16>
+        {};
+#endif
+
+        template<typename RandomAccessIterator, typename Projection>
+        using sort_function_t = void (*)(RandomAccessIterator, RandomAccessIterator,
+                                         std::ptrdiff_t, Projection, void*);
+
+        template<typename CurrentSubKey, std::size_t NumBytes, std::size_t Offset>
+        struct parallel_byte_sorter
+        {
+            using sequential_sorter = UnsignedInplaceSorter<
+                std_sort_threshold, american_flag_sort_threshold,
+                CurrentSubKey, NumBytes, Offset
+            >;
+            using next_sorter = parallel_byte_sorter<CurrentSubKey, NumBytes, Offset + 1>;
+
+            // Sorts [begin, end) starting from the byte Offset of the
+            // sub-key, buffer must be able to hold end - begin elements
+            template<typename RandomAccessIterator, typename Projection>
+            static auto sort(RandomAccessIterator begin, RandomAccessIterator end,
+                             rvalue_type_t<RandomAccessIterator>* buffer, Projection projection,
+                             sort_function_t<RandomAccessIterator, Projection> next_sort)
+                -> void
+            {
+                using difference_type = difference_type_t<RandomAccessIterator>;
+                using rvalue_type = rvalue_type_t<RandomAccessIterator>;
+                using utility::iter_move;
+                auto&& proj = utility::as_function(projection);
+
+                difference_type size = end - begin;
+                std::size_t nb_chunks = (std::max)(
+                    std::size_t(1),
+                    (std::min)(thread_pool::instance().concurrency(),
+                               static_cast<std::size_t>(size / min_chunk_size))
+                );
+                auto chunk_bound = [&](std::size_t idx) {
+                    return static_cast<difference_type>(size * idx / nb_chunks);
+                };
+
+                // Compute the histogram of every chunk
+                std::vector<std::array<std::size_t, 256>> offsets(nb_chunks);
+                {
+                    task_group group;
+                    for (std::size_t idx = 0 ; idx < nb_chunks ; ++idx) {
+                        group.run([&, idx] {
+                            auto& counts = offsets[idx];
+                            counts.fill(0);
+                            for (auto it = begin + chunk_bound(idx) ; it != begin + chunk_bound(idx + 1) ; ++it) {
+                                ++counts[sequential_sorter::current_byte(proj(*it), nullptr)];
+                            }
+                        });
+                    }
+                    group.wait();
+                }
+
+                // Turn the histograms into the offsets where every chunk
+                // writes its elements: buckets are laid out one after the
+                // other, and the part of a bucket written by a chunk comes
+                // after the parts written by the previous chunks
+                std::size_t bucket_bounds[257];
+                std::size_t total = 0;
+                std::size_t nb_buckets = 0;
+                for (std::size_t bucket = 0 ; bucket < 256 ; ++bucket) {
+                    bucket_bounds[bucket] = total;
+                    std::size_t bucket_size = 0;
+                    for (auto& counts: offsets) {
+                        std::size_t count = counts[bucket];
+                        counts[bucket] = total + bucket_size;
+                        bucket_size += count;
+                    }
+                    total += bucket_size;
+                    nb_buckets += (bucket_size != 0);
+                }
+                bucket_bounds[256] = total;
+
+                // When every element falls in the same bucket, there is
+                // nothing to move and we can directly handle the next byte
+                if (nb_buckets > 1) {
+                    {
+                        task_group group;
+                        for (std::size_t idx = 0 ; idx < nb_chunks ; ++idx) {
+                            group.run([&, idx] {
+                                auto& chunk_offsets = offsets[idx];
+                                for (auto it = begin + chunk_bound(idx) ; it != begin + chunk_bound(idx + 1) ; ++it) {
+                                    auto byte = sequential_sorter::current_byte(proj(*it), nullptr);
+                                    ::new(buffer + chunk_offsets[byte]++) rvalue_type(iter_move(it));
+                                }
+                            });
+                        }
+                        group.wait();
+                    }
+                    {
+                        task_group group;
+                        for (std::size_t idx = 0 ; idx < nb_chunks ; ++idx) {
+                            group.run([&, idx] {
+                                detail::move(buffer + chunk_bound(idx), buffer + chunk_bound(idx + 1),
+                                             begin + chunk_bound(idx));
+                                detail::destroy(buffer + chunk_bound(idx), buffer + chunk_bound(idx + 1));
+                            });
+                        }
+                        group.wait();
+                    }
+                }
+
+                // Sort every bucket in its own task
+                if (Offset + 1 == NumBytes && not next_sort) {
+                    return;
+                }
+                task_group group;
+                for (std::size_t bucket = 0 ; bucket < 256 ; ++bucket) {
+                    std::size_t start_offset = bucket_bounds[bucket];
+                    std::size_t end_offset = bucket_bounds[bucket + 1];
+                    if (end_offset - start_offset < 2) continue;
+
+                    group.run([=] {
+                        auto partition_begin = begin + static_cast<difference_type>(start_offset);
+                        auto partition_end = begin + static_cast<difference_type>(end_offset);
+                        auto num_elements = static_cast<std::ptrdiff_t>(end_offset - start_offset);
+                        if (Offset + 1 < NumBytes && num_elements >= min_parallel_size) {
+                            next_sorter::sort(partition_begin, partition_end, buffer + start_offset,
+                                              projection, next_sort);
+                        } else {
+                            sequential_sorter::sort_partition(partition_begin, partition_end, num_elements,
+                                                              projection, next_sort, nullptr);
+                        }
+                    });
+                }
+                group.wait();
+            }
+        };
+
+        template<typename CurrentSubKey, std::size_t NumBytes>
+        struct parallel_byte_sorter<CurrentSubKey, NumBytes, NumBytes>
+        {
+            // Never called: there is no byte left to handle
+            template<typename RandomAccessIterator, typename Projection>
+            static auto sort(RandomAccessIterator, RandomAccessIterator,
+                             rvalue_type_t<RandomAccessIterator>*, Projection,
+                             sort_function_t<RandomAccessIterator, Projection>)
+                -> void
+            {}
+        };
+
+        template<typename RandomAccessIterator, typename Projection>
+        auto parallel_ska_sort_start(RandomAccessIterator begin, RandomAccessIterator end,
+                                     Projection projection, std::false_type)
+            -> void
+        {
+            ska_sort(std::move(begin), std::move(end), std::move(projection));
+        }
+
+        template<typename RandomAccessIterator, typename Projection>
+        auto parallel_ska_sort_start(RandomAccessIterator begin, RandomAccessIterator end,
+                                     Projection projection, std::true_type)
+            -> void
+        {
+            using rvalue_type = rvalue_type_t<RandomAccessIterator>;
+            using sub_key = SubKey<projected_t<RandomAccessIterator, Projection>>;
+            using sort_function = sort_function_t<RandomAccessIterator, Projection>;
+            constexpr std::size_t num_bytes = radix_bytes<typename sub_key::sub_key_type>::value;
+
+            auto size = end - begin;
+            if (size < min_parallel_size || thread_pool::instance().concurrency() == 1) {
+                ska_sort(std::move(begin), std::move(end), std::move(projection));
+                return;
+            }
+
+            // Allocate the scatter buffer upfront, fall back to the
+            // sequential algorithm - which sorts in-place - if we can't
+            std::unique_ptr<rvalue_type, operator_deleter> buffer(
+                static_cast<rvalue_type*>(::operator new(size * sizeof(rvalue_type), std::nothrow)),
+                operator_deleter(size * sizeof(rvalue_type))
+            );
+            if (buffer == nullptr) {
+                ska_sort(std::move(begin), std::move(end), std::move(projection));
+                return;
+            }
+
+            // Same sort function for the next sub-key as SortStarter
+            using next_starter = SortStarter<
+                std_sort_threshold, american_flag_sort_threshold,
+                typename sub_key::next
+            >;
+            using void_starter = SortStarter<
+                std_sort_threshold, american_flag_sort_threshold,
+                SubKey<void>
+            >;
+            sort_function next_sort = static_cast<sort_function>(&next_starter::sort);
+            if (next_sort == static_cast<sort_function>(&void_starter::sort)) {
+                next_sort = nullptr;
+            }
+
+            parallel_byte_sorter<sub_key, num_bytes, 0>::sort(
+                std::move(begin), std::move(end), buffer.get(),
+                std::move(projection), next_sort);
+        }
+    }
+
+    template<typename RandomAccessIterator, typename Projection>
+    auto parallel_ska_sort(RandomAccessIterator begin, RandomAccessIterator end,
+                           Projection projection)
+        -> void
+    {
+        // Only the sub-keys that are unsigned integers are handled in
+        // parallel, the parallel passes also require moves not to throw
+        // since elements are scattered out of the collection
+        using rvalue_type = rvalue_type_t<RandomAccessIterator>;
+        using sub_key = SubKey<projected_t<RandomAccessIterator, Projection>>;
+        using can_run_parallel = std::integral_constant<bool,
+            parallel_ska_sort_detail::radix_bytes<typename sub_key::sub_key_type>::value != 0 &&
+            std::is_nothrow_move_constructible<rvalue_type>::value &&
+            std::is_nothrow_move_assignable<rvalue_type>::value
+        >;
+
+        parallel_ska_sort_detail::parallel_ska_sort_start(std::move(begin), std::move(end),
+                                                          std::move(projection),
+                                                          can_run_parallel{});
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PARALLEL_SKA_SORT_H_
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_PARALLEL_SPINSORT_H_
+#define CPPSORT_DETAIL_PARALLEL_SPINSORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+#include "iterator_traits.h"
+#include "memory.h"
+#include "parallel_multiway_merge.h"
+#include "spinsort.h"
+#include "thread_pool.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Parallel spinsort
+    //
+    // Similar to Boost.Sort's parallel_stable_sort: a buffer big
+    // enough to hold the whole collection is allocated once, then
+    // the collection is cut into one chunk per thread and every
+    // chunk is sorted concurrently with spinsort, using the slice
+    // of the buffer matching its position in the collection. The
+    // sorted chunks are finally merged with a parallel multiway
+    // merge into the same buffer.
+
+    namespace parallel_spinsort_detail
+    {
+        enum {
+            // Minimum number of elements sorted by a single task
+            min_chunk_size = 1 << 13
+        };
+    }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto parallel_spinsort(RandomAccessIterator first, RandomAccessIterator last,
+                           Compare compare, Projection projection)
+        -> void
+    {
+        using difference_type = difference_type_t<RandomAccessIterator>;
+        using rvalue_type = rvalue_type_t<RandomAccessIterator>;
+        using parallel_spinsort_detail::min_chunk_size;
+
+        auto size = last - first;
+        auto concurrency = thread_pool::instance().concurrency();
+        if (size < 2 * min_chunk_size || concurrency == 1) {
+            spinsort(std::move(first), std::move(last),
+                     std::move(compare), std::move(projection));
+            return;
+        }
+
+        // Allocate the buffer upfront, fall back to the sequential
+        // algorithm - which needs half as much memory - if we can't
+        std::unique_ptr<rvalue_type, operator_deleter> buffer(
+            static_cast<rvalue_type*>(::operator new(size * sizeof(rvalue_type), std::nothrow)),
+            operator_deleter(size * sizeof(rvalue_type))
+        );
+        if (buffer == nullptr) {
+            spinsort(std::move(first), std::move(last),
+                     std::move(compare), std::move(projection));
+            return;
+        }
+
+        // Sort one chunk per thread, each with its own slice of the buffer
+        auto nb_chunks = (std::min)(concurrency, static_cast<std::size_t>(size / min_chunk_size));
+        std::vector<RandomAccessIterator> bounds;
+        bounds.reserve(nb_chunks + 1);
+        for (std::size_t idx = 0 ; idx <= nb_chunks ; ++idx) {
+            bounds.push_back(first + static_cast<difference_type>(size * idx / nb_chunks));
+        }
+
+        {
+            task_group group;
+            for (std::size_t idx = 0 ; idx < nb_chunks ; ++idx) {
+                group.run([&, idx] {
+                    spinsort(bounds[idx], bounds[idx + 1], compare, projection,
+                             buffer.get() + (bounds[idx] - first));
+                });
+            }
+            group.wait();
+        }
+
+        // Merge the sorted chunks, every thread writing its own slice
+        parallel_multiway_merge(bounds, buffer.get(), nb_chunks,
+                                std::move(compare), std::move(projection));
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PARALLEL_SPINSORT_H_
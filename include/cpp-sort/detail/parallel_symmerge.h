@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_PARALLEL_SYMMERGE_H_
+#define CPPSORT_DETAIL_PARALLEL_SYMMERGE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include <cpp-sort/comparators/flip.h>
+#include "buffered_inplace_merge.h"
+#include "iterator_traits.h"
+#include "move.h"
+#include "parallel_merge_tree.h"
+#include "rotate.h"
+#include "symmerge.h"
+#include "thread_pool.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Parallel symmerge
+    //
+    // Rotation-based merge algorithm that doesn't need any extra
+    // memory: every split performed by symmerge produces two
+    // independent merges, which are performed concurrently as long
+    // as there are threads left to perform them. Every task gets
+    // its own buffer from the buffer provider, and the merges small
+    // enough for one of the runs to fit in that buffer are performed
+    // with a regular buffered merge. Unlike the buffers used by the
+    // other merge algorithms, these buffers already hold constructed
+    // elements, which makes them compatible with the buffers used by
+    // the block sorts of the library.
+
+    namespace parallel_symmerge_detail
+    {
+        enum {
+            // Minimum number of elements sorted by a single task
+            min_chunk_size = 1 << 13,
+
+            // Minimum number of elements to merge in parallel
+            min_parallel_merge_size = 1 << 15
+        };
+
+        template<typename RandomAccessIterator, typename BufferIterator,
+                 typename Compare, typename Projection>
+        auto merge_with_buffer(RandomAccessIterator first, RandomAccessIterator middle,
+                               RandomAccessIterator last, BufferIterator buffer,
+                               Compare compare, Projection projection)
+            -> void
+        {
+            auto len1 = middle - first;
+            auto len2 = last - middle;
+            if (len1 <= len2) {
+                auto buffer_last = detail::move(first, middle, buffer);
+                half_inplace_merge(buffer, buffer_last, middle, last, first, len1,
+                                   std::move(compare), std::move(projection));
+            } else {
+                auto buffer_last = detail::move(middle, last, buffer);
+                using rbi = std::reverse_iterator<RandomAccessIterator>;
+                using rbuf = std::reverse_iterator<BufferIterator>;
+                half_inplace_merge(rbuf(buffer_last), rbuf(buffer),
+                                   rbi(middle), rbi(first),
+                                   rbi(last), len2,
+                                   cppsort::flip(compare), std::move(projection));
+            }
+        }
+
+        template<typename BufferProvider, typename RandomAccessIterator,
+                 typename BufferIterator, typename Compare, typename Projection>
+        auto symmerge(RandomAccessIterator first, RandomAccessIterator middle,
+                      RandomAccessIterator last, std::size_t nb_tasks,
+                      BufferIterator buffer, std::ptrdiff_t buffer_size,
+                      Compare compare, Projection projection)
+            -> void;
+    }
+
+    template<typename BufferProvider, typename RandomAccessIterator,
+             typename Compare, typename Projection>
+    auto parallel_symmerge(RandomAccessIterator first, RandomAccessIterator middle,
+                           RandomAccessIterator last, std::size_t nb_tasks,
+                           Compare compare, Projection projection)
+        -> void
+    {
+        using rvalue_type = rvalue_type_t<RandomAccessIterator>;
+        typename BufferProvider::template buffer<rvalue_type> buffer(last - first);
+        parallel_symmerge_detail::symmerge<BufferProvider>(
+            first, middle, last, nb_tasks,
+            buffer.begin(), buffer.size(),
+            std::move(compare), std::move(projection)
+        );
+    }
+
+    namespace parallel_symmerge_detail
+    {
+        template<typename BufferProvider, typename RandomAccessIterator,
+                 typename BufferIterator, typename Compare, typename Projection>
+        auto symmerge(RandomAccessIterator first, RandomAccessIterator middle,
+                      RandomAccessIterator last, std::size_t nb_tasks,
+                      BufferIterator buffer, std::ptrdiff_t buffer_size,
+                      Compare compare, Projection projection)
+            -> void
+        {
+            while (first != middle && middle != last) {
+                auto len1 = middle - first;
+                auto len2 = last - middle;
+                if (len1 <= buffer_size || len2 <= buffer_size) {
+                    merge_with_buffer(first, middle, last, buffer,
+                                      std::move(compare), std::move(projection));
+                    return;
+                }
+
+                // Once the rotation is performed, the merges of
+                // [first, first + m) and [first + m, last) are independent
+                auto size = last - first;
+                auto m = size / 2;
+                auto n = m + len1;
+                auto start = len1 > m ?
+                    symmerge_bsearch(first, n - size, m, n - 1, compare, projection) :
+                    symmerge_bsearch(first, 0, len1, n - 1, compare, projection);
+                auto end = n - start;
+                detail::rotate(first + start, middle, first + end);
+
+                if (nb_tasks > 1 && size >= min_parallel_merge_size) {
+                    task_group group;
+                    group.run([&] {
+                        parallel_symmerge<BufferProvider>(first, first + start, first + m,
+                                                          nb_tasks / 2, compare, projection);
+                    });
+                    symmerge<BufferProvider>(first + m, first + end, last,
+                                             nb_tasks - nb_tasks / 2,
+                                             buffer, buffer_size, compare, projection);
+                    group.wait();
+                    return;
+                }
+
+                symmerge<BufferProvider>(first, first + start, first + m, 1,
+                                         buffer, buffer_size, compare, projection);
+                // Unrolled tail recursion, last doesn't change
+                middle = first + end;
+                first += m;
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Parallel chunk sort followed by parallel symmerges
+    //
+    // Driver for the block sorts whose block merges can't run
+    // concurrently: the collection is cut into one chunk per
+    // thread, and every chunk is sorted concurrently by the given
+    // chunk sorter, which gets its own memory from the buffer
+    // provider. The sorted chunks are then merged pairwise with
+    // a parallel symmerge. Only the chunk sorts and these final
+    // merges are parallel, the block merges performed by the
+    // chunk sorter within a chunk are still sequential.
+
+    template<typename BufferProvider, typename RandomAccessIterator,
+             typename Compare, typename Projection, typename ChunkSorter>
+    auto parallel_chunk_sort_then_symmerge(RandomAccessIterator first, RandomAccessIterator last,
+                                           Compare compare, Projection projection,
+                                           ChunkSorter chunk_sorter)
+        -> void
+    {
+        using difference_type = difference_type_t<RandomAccessIterator>;
+        using parallel_symmerge_detail::min_chunk_size;
+
+        auto size = last - first;
+        auto concurrency = thread_pool::instance().concurrency();
+        if (size < 2 * min_chunk_size || concurrency == 1) {
+            chunk_sorter(std::move(first), std::move(last),
+                         std::move(compare), std::move(projection));
+            return;
+        }
+
+        // Sort one chunk per thread
+        auto nb_chunks = (std::min)(concurrency, static_cast<std::size_t>(size / min_chunk_size));
+        std::vector<RandomAccessIterator> bounds;
+        bounds.reserve(nb_chunks + 1);
+        for (std::size_t idx = 0 ; idx <= nb_chunks ; ++idx) {
+            bounds.push_back(first + static_cast<difference_type>(size * idx / nb_chunks));
+        }
+
+        {
+            task_group group;
+            for (std::size_t idx = 0 ; idx < nb_chunks ; ++idx) {
+                group.run([&, idx] {
+                    chunk_sorter(bounds[idx], bounds[idx + 1], compare, projection);
+                });
+            }
+            group.wait();
+        }
+
+        parallel_merge_tree(
+            bounds, compare, projection,
+            [&](RandomAccessIterator merge_first, RandomAccessIterator merge_middle,
+                RandomAccessIterator merge_last, std::size_t nb_tasks) {
+                parallel_symmerge<BufferProvider>(merge_first, merge_middle, merge_last,
+                                                  nb_tasks, compare, projection);
+            }
+        );
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PARALLEL_SYMMERGE_H_
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_PARALLEL_TIMSORT_H_
+#define CPPSORT_DETAIL_PARALLEL_TIMSORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "iterator_traits.h"
+#include "parallel_merge_tree.h"
+#include "thread_pool.h"
+#include "timsort.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Parallel TimSort
+    //
+    // The collection is cut into one segment per thread, and the
+    // segments are sorted concurrently with TimSort, each of them
+    // finding and merging its own natural runs. The sorted segments
+    // are then merged with a parallel merge tree, which coalesces
+    // the consecutive segments that are already in order.
+
+    namespace parallel_timsort_detail
+    {
+        enum {
+            // Minimum number of elements sorted by a single task
+            min_chunk_size = 1 << 13
+        };
+    }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto parallel_timsort(RandomAccessIterator first, RandomAccessIterator last,
+                          Compare compare, Projection projection)
+        -> void
+    {
+        using difference_type = difference_type_t<RandomAccessIterator>;
+        using parallel_timsort_detail::min_chunk_size;
+
+        auto size = last - first;
+        auto concurrency = thread_pool::instance().concurrency();
+        if (size < 2 * min_chunk_size || concurrency == 1) {
+            timsort(std::move(first), std::move(last),
+                    std::move(compare), std::move(projection));
+            return;
+        }
+
+        // Sort one segment per thread
+        auto nb_chunks = (std::min)(concurrency, static_cast<std::size_t>(size / min_chunk_size));
+        std::vector<RandomAccessIterator> bounds;
+        bounds.reserve(nb_chunks + 1);
+        for (std::size_t idx = 0 ; idx <= nb_chunks ; ++idx) {
+            bounds.push_back(first + static_cast<difference_type>(size * idx / nb_chunks));
+        }
+
+        {
+            task_group group;
+            for (std::size_t idx = 0 ; idx < nb_chunks ; ++idx) {
+                group.run([&, idx] {
+                    timsort(bounds[idx], bounds[idx + 1], compare, projection);
+                });
+            }
+            group.wait();
+        }
+
+        parallel_merge_tree(bounds, std::move(compare), std::move(projection));
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PARALLEL_TIMSORT_H_
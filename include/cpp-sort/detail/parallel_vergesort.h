@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_PARALLEL_VERGESORT_H_
+#define CPPSORT_DETAIL_PARALLEL_VERGESORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cpp-sort/utility/as_function.h>
+#include "bitops.h"
+#include "iterator_traits.h"
+#include "parallel_merge_tree.h"
+#include "reverse.h"
+#include "thread_pool.h"
+#include "vergesort.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Parallel vergesort
+    //
+    // The collection is cut into one chunk per thread, and every
+    // chunk is concurrently scanned for runs bigger than vergesort's
+    // n / log n threshold. The first and last runs of every chunk
+    // are always kept regardless of their size, so that the runs
+    // crossing the chunk boundaries can be stitched back together
+    // once all the chunks have been scanned. The descending runs
+    // are then reversed and the unsorted segments between the runs
+    // are sorted with the fallback sorter, all of that concurrently:
+    // big unsorted segments are cut into several pieces to keep all
+    // the threads busy. The resulting runs are finally merged with
+    // a parallel merge tree.
+
+    namespace parallel_verge_detail
+    {
+        enum {
+            // Minimum number of elements handled by a single task
+            min_chunk_size = 1 << 13
+        };
+
+        enum struct segment_kind
+        {
+            ascending,
+            descending,
+            unsorted
+        };
+
+        template<typename Iterator>
+        struct segment
+        {
+            Iterator first;
+            Iterator last;
+            segment_kind kind;
+        };
+
+        // Finds the runs of [first, last), adjacent runs that are not
+        // big enough are gathered into unsorted segments
+        template<bool Stable, typename RandomAccessIterator, typename Compare, typename Projection>
+        auto find_runs(RandomAccessIterator first, RandomAccessIterator last,
+                       difference_type_t<RandomAccessIterator> minrun_limit,
+                       Compare compare, Projection projection)
+            -> std::vector<segment<RandomAccessIterator>>
+        {
+            auto&& comp = utility::as_function(compare);
+            auto&& proj = utility::as_function(projection);
+
+            std::vector<segment<RandomAccessIterator>> segments;
+            auto current = first;
+            while (current != last) {
+                auto begin_run = current;
+                auto next = std::next(current);
+                auto kind = segment_kind::ascending;
+                if (next != last) {
+                    if (comp(proj(*next), proj(*current))) {
+                        kind = segment_kind::descending;
+                        if (Stable) {
+                            // Find a strictly descending run to avoid breaking
+                            // the stability of the algorithm with reverse()
+                            do {
+                                ++current;
+                                ++next;
+                            } while (next != last && comp(proj(*next), proj(*current)));
+                        } else {
+                            // Find a non-ascending run
+                            do {
+                                ++current;
+                                ++next;
+                            } while (next != last && not comp(proj(*current), proj(*next)));
+                        }
+                    } else {
+                        // Find a non-descending run
+                        do {
+                            ++current;
+                            ++next;
+                        } while (next != last && not comp(proj(*next), proj(*current)));
+                    }
+                }
+                current = next;
+
+                // The runs at the edges of the chunk might be part of
+                // bigger runs crossing the chunk boundaries
+                if (begin_run == first || current == last || current - begin_run > minrun_limit) {
+                    segments.push_back({ begin_run, current, kind });
+                } else if (not segments.empty() && segments.back().kind == segment_kind::unsorted) {
+                    segments.back().last = current;
+                } else {
+                    segments.push_back({ begin_run, current, segment_kind::unsorted });
+                }
+            }
+            return segments;
+        }
+
+        // Whether the run of the given kind ending at middle goes on
+        // with the run of the same kind starting at middle
+        template<bool Stable, typename RandomAccessIterator, typename Compare, typename Projection>
+        auto is_run_continued(RandomAccessIterator middle, segment_kind kind,
+                              Compare compare, Projection projection)
+            -> bool
+        {
+            auto&& comp = utility::as_function(compare);
+            auto&& proj = utility::as_function(projection);
+
+            auto&& lhs = proj(*std::prev(middle));
+            auto&& rhs = proj(*middle);
+            if (kind == segment_kind::ascending) {
+                return not comp(rhs, lhs);
+            }
+            return Stable ? comp(rhs, lhs) : not comp(lhs, rhs);
+        }
+    }
+
+    template<bool Stable, typename RandomAccessIterator, typename Compare, typename Projection>
+    auto parallel_vergesort(RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare, Projection projection)
+        -> void
+    {
+        using difference_type = difference_type_t<RandomAccessIterator>;
+        using namespace parallel_verge_detail;
+        using segment_type = segment<RandomAccessIterator>;
+
+        auto size = last - first;
+        auto concurrency = thread_pool::instance().concurrency();
+        if (size < 2 * min_chunk_size || concurrency == 1) {
+            verge::sort<Stable>(std::move(first), std::move(last), size,
+                                std::move(compare), std::move(projection));
+            return;
+        }
+
+        const difference_type minrun_limit = size / log2(size);
+
+        // Find the runs of every chunk concurrently
+        auto nb_chunks = (std::min)(concurrency, static_cast<std::size_t>(size / min_chunk_size));
+        std::vector<std::vector<segment_type>> chunks_segments(nb_chunks);
+        {
+            task_group group;
+            for (std::size_t idx = 0 ; idx < nb_chunks ; ++idx) {
+                group.run([&, idx] {
+                    auto chunk_first = first + static_cast<difference_type>(size * idx / nb_chunks);
+                    auto chunk_last = first + static_cast<difference_type>(size * (idx + 1) / nb_chunks);
+                    chunks_segments[idx] = find_runs<Stable>(chunk_first, chunk_last, minrun_limit,
+                                                             compare, projection);
+                });
+            }
+            group.wait();
+        }
+
+        // Stitch the runs crossing the chunk boundaries
+        std::vector<segment_type> segments;
+        for (auto& chunk_segments: chunks_segments) {
+            auto it = chunk_segments.begin();
+            if (not segments.empty()) {
+                auto& back = segments.back();
+                if (back.kind != segment_kind::unsorted && back.kind == it->kind &&
+                    is_run_continued<Stable>(it->first, back.kind, compare, projection)) {
+                    back.last = it->last;
+                    ++it;
+                }
+            }
+            segments.insert(segments.end(), it, chunk_segments.end());
+        }
+
+        // Runs that are still too small become unsorted segments
+        std::size_t out = 0;
+        for (auto& seg: segments) {
+            if (seg.kind != segment_kind::unsorted && seg.last - seg.first <= minrun_limit) {
+                seg.kind = segment_kind::unsorted;
+            }
+            if (out != 0 && seg.kind == segment_kind::unsorted &&
+                segments[out - 1].kind == segment_kind::unsorted) {
+                segments[out - 1].last = seg.last;
+            } else {
+                segments[out++] = seg;
+            }
+        }
+        segments.resize(out);
+
+        // Reverse the descending runs and sort the unsorted segments
+        // concurrently, every piece becoming a run to merge
+        auto fallback = verge::get_maybe_stable(std::integral_constant<bool, Stable>{},
+                                                verge::default_sorter_for(first));
+        auto max_piece_size = (std::max)(static_cast<difference_type>(min_chunk_size),
+                                         static_cast<difference_type>((size + concurrency - 1) / concurrency));
+        std::vector<RandomAccessIterator> bounds = { first };
+        {
+            task_group group;
+            for (auto& seg: segments) {
+                if (seg.kind == segment_kind::descending) {
+                    group.run([&seg] {
+                        detail::reverse(seg.first, seg.last);
+                    });
+                    bounds.push_back(seg.last);
+                } else if (seg.kind == segment_kind::ascending) {
+                    bounds.push_back(seg.last);
+                } else {
+                    auto seg_size = seg.last - seg.first;
+                    auto nb_pieces = (seg_size + max_piece_size - 1) / max_piece_size;
+                    for (difference_type idx = 0 ; idx < nb_pieces ; ++idx) {
+                        auto piece_first = seg.first + seg_size * idx / nb_pieces;
+                        auto piece_last = seg.first + seg_size * (idx + 1) / nb_pieces;
+                        group.run([&, piece_first, piece_last] {
+                            fallback(piece_first, piece_last, compare, projection);
+                        });
+                        bounds.push_back(piece_last);
+                    }
+                }
+            }
+            group.wait();
+        }
+
+        parallel_merge_tree(bounds, std::move(compare), std::move(projection));
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PARALLEL_VERGESORT_H_
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_PARALLEL_WIKISORT_H_
+#define CPPSORT_DETAIL_PARALLEL_WIKISORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <utility>
+#include "parallel_symmerge.h"
+#include "wiki_sort.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Parallel WikiSort
+    //
+    // The A and B blocks merged at a given level of WikiSort all
+    // rely on the internal buffers pulled out of the collection at
+    // the beginning of that level, which prevents the merges of a
+    // level from running concurrently: chunks of the collection
+    // are sorted with WikiSort then merged with parallel symmerges.
+
+    template<typename BufferProvider, typename RandomAccessIterator,
+             typename Compare, typename Projection>
+    auto parallel_wikisort(RandomAccessIterator first, RandomAccessIterator last,
+                           Compare compare, Projection projection)
+        -> void
+    {
+        parallel_chunk_sort_then_symmerge<BufferProvider>(
+            std::move(first), std::move(last),
+            std::move(compare), std::move(projection),
+            [](RandomAccessIterator chunk_first, RandomAccessIterator chunk_last,
+               Compare chunk_compare, Projection chunk_projection) {
+                wiki_sort<BufferProvider>(std::move(chunk_first), std::move(chunk_last),
+                                          std::move(chunk_compare), std::move(chunk_projection));
+            }
+        );
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PARALLEL_WIKISORT_H_
@@ -32,6 +32,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <iterator>
+#include <type_traits>
 #include <utility>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/branchless_traits.h>
@@ -41,6 +42,8 @@
 #include "insertion_sort.h"
 #include "iterator_traits.h"
 #include "iter_sort3.h"
+#include "pdqsort_simd.h"
+#include "simd_traits.h"
 
 #ifdef __MINGW32__
 #   include <cstdint> // std::uintptr_t
@@ -184,6 +187,81 @@ namespace detail
             }
         }
 
+        // Fills a whole block of offsets with the positions of the elements of
+        // [first, first + block_size) that are not less than the pivot, and
+        // returns the number of such elements.
+        template<typename RandomAccessIterator, typename T, typename Compare, typename Projection>
+        auto fill_offsets_block_l(RandomAccessIterator first, T& pivot_proj,
+                                  unsigned char* offsets_l, Compare compare, Projection projection,
+                                  std::false_type /* use_simd */)
+            -> std::size_t
+        {
+            auto&& comp = utility::as_function(compare);
+            auto&& proj = utility::as_function(projection);
+
+            std::size_t num_l = 0;
+            for (std::size_t i = 0 ; i < block_size ;) {
+                offsets_l[num_l] = i++; num_l += not comp(proj(*first), pivot_proj); ++first;
+                offsets_l[num_l] = i++; num_l += not comp(proj(*first), pivot_proj); ++first;
+                offsets_l[num_l] = i++; num_l += not comp(proj(*first), pivot_proj); ++first;
+                offsets_l[num_l] = i++; num_l += not comp(proj(*first), pivot_proj); ++first;
+                offsets_l[num_l] = i++; num_l += not comp(proj(*first), pivot_proj); ++first;
+                offsets_l[num_l] = i++; num_l += not comp(proj(*first), pivot_proj); ++first;
+                offsets_l[num_l] = i++; num_l += not comp(proj(*first), pivot_proj); ++first;
+                offsets_l[num_l] = i++; num_l += not comp(proj(*first), pivot_proj); ++first;
+            }
+            return num_l;
+        }
+
+        // Same as above for the elements of [last - block_size, last) that are
+        // less than the pivot, the offsets being distances from last.
+        template<typename RandomAccessIterator, typename T, typename Compare, typename Projection>
+        auto fill_offsets_block_r(RandomAccessIterator last, T& pivot_proj,
+                                  unsigned char* offsets_r, Compare compare, Projection projection,
+                                  std::false_type /* use_simd */)
+            -> std::size_t
+        {
+            auto&& comp = utility::as_function(compare);
+            auto&& proj = utility::as_function(projection);
+
+            std::size_t num_r = 0;
+            for (std::size_t i = 0 ; i < block_size ;) {
+                offsets_r[num_r] = ++i; num_r += comp(proj(*--last), pivot_proj);
+                offsets_r[num_r] = ++i; num_r += comp(proj(*--last), pivot_proj);
+                offsets_r[num_r] = ++i; num_r += comp(proj(*--last), pivot_proj);
+                offsets_r[num_r] = ++i; num_r += comp(proj(*--last), pivot_proj);
+                offsets_r[num_r] = ++i; num_r += comp(proj(*--last), pivot_proj);
+                offsets_r[num_r] = ++i; num_r += comp(proj(*--last), pivot_proj);
+                offsets_r[num_r] = ++i; num_r += comp(proj(*--last), pivot_proj);
+                offsets_r[num_r] = ++i; num_r += comp(proj(*--last), pivot_proj);
+            }
+            return num_r;
+        }
+
+#if CPPSORT_AVX2_AVAILABLE || CPPSORT_AVX512F_AVAILABLE
+        // When possible, compare the whole block to the pivot at once
+        // with vector instructions, see pdqsort_simd.h
+        template<typename RandomAccessIterator, typename T, typename Compare, typename Projection>
+        auto fill_offsets_block_l(RandomAccessIterator first, T& pivot_proj,
+                                  unsigned char* offsets_l, Compare, Projection,
+                                  std::true_type /* use_simd */)
+            -> std::size_t
+        {
+            static_assert(block_size == simd_block_size, "");
+            return simd_fill_offsets_l<simd_compare_order<Compare>::value>(first, pivot_proj, offsets_l);
+        }
+
+        template<typename RandomAccessIterator, typename T, typename Compare, typename Projection>
+        auto fill_offsets_block_r(RandomAccessIterator last, T& pivot_proj,
+                                  unsigned char* offsets_r, Compare, Projection,
+                                  std::true_type /* use_simd */)
+            -> std::size_t
+        {
+            static_assert(block_size == simd_block_size, "");
+            return simd_fill_offsets_r<simd_compare_order<Compare>::value>(last, pivot_proj, offsets_r);
+        }
+#endif
+
         // Partitions [begin, end) around pivot *begin using comparison function compare. Elements equal
         // to the pivot are put in the right-hand partition. Returns the position of the pivot after
         // partitioning and whether the passed sequence already was correctly partitioned. Assumes the
@@ -196,6 +274,10 @@ namespace detail
         {
             using utility::iter_move;
             using utility::iter_swap;
+            using use_simd = std::integral_constant<
+                bool,
+                use_simd_partition<RandomAccessIterator, Compare, Projection>()
+            >;
             auto&& comp = utility::as_function(compare);
             auto&& proj = utility::as_function(projection);
 
@@ -251,16 +333,9 @@ namespace detail
 
                     // Fill the offset blocks.
                     if (left_split >= block_size) {
-                        for (std::size_t i = 0 ; i < block_size ;) {
-                            offsets_l[num_l] = i++; num_l += not comp(proj(*first), pivot_proj); ++first;
-                            offsets_l[num_l] = i++; num_l += not comp(proj(*first), pivot_proj); ++first;
-                            offsets_l[num_l] = i++; num_l += not comp(proj(*first), pivot_proj); ++first;
-                            offsets_l[num_l] = i++; num_l += not comp(proj(*first), pivot_proj); ++first;
-                            offsets_l[num_l] = i++; num_l += not comp(proj(*first), pivot_proj); ++first;
-                            offsets_l[num_l] = i++; num_l += not comp(proj(*first), pivot_proj); ++first;
-                            offsets_l[num_l] = i++; num_l += not comp(proj(*first), pivot_proj); ++first;
-                            offsets_l[num_l] = i++; num_l += not comp(proj(*first), pivot_proj); ++first;
-                        }
+                        num_l = fill_offsets_block_l(first, pivot_proj, offsets_l,
+                                                     compare, projection, use_simd{});
+                        first += block_size;
                     } else {
                         for (std::size_t i = 0 ; i < left_split ;) {
                             offsets_l[num_l] = i++;
@@ -270,16 +345,9 @@ namespace detail
                     }
 
                     if (right_split >= block_size) {
-                        for (std::size_t i = 0 ; i < block_size ;) {
-                            offsets_r[num_r] = ++i; num_r += comp(proj(*--last), pivot_proj);
-                            offsets_r[num_r] = ++i; num_r += comp(proj(*--last), pivot_proj);
-                            offsets_r[num_r] = ++i; num_r += comp(proj(*--last), pivot_proj);
-                            offsets_r[num_r] = ++i; num_r += comp(proj(*--last), pivot_proj);
-                            offsets_r[num_r] = ++i; num_r += comp(proj(*--last), pivot_proj);
-                            offsets_r[num_r] = ++i; num_r += comp(proj(*--last), pivot_proj);
-                            offsets_r[num_r] = ++i; num_r += comp(proj(*--last), pivot_proj);
-                            offsets_r[num_r] = ++i; num_r += comp(proj(*--last), pivot_proj);
-                        }
+                        num_r = fill_offsets_block_r(last, pivot_proj, offsets_r,
+                                                     compare, projection, use_simd{});
+                        last -= block_size;
                     } else {
                         for (std::size_t i = 0 ; i < right_split ;) {
                             offsets_r[num_r] = ++i;
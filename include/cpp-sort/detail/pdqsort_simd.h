@@ -0,0 +1,407 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_PDQSORT_SIMD_H_
+#define CPPSORT_DETAIL_PDQSORT_SIMD_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include "config.h"
+#include "iterator_traits.h"
+#include "simd_traits.h"
+#include "type_traits.h"
+
+#if CPPSORT_AVX2_AVAILABLE || CPPSORT_AVX512F_AVAILABLE
+#   include <immintrin.h>
+#endif
+
+namespace cppsort
+{
+namespace detail
+{
+namespace pdqsort_detail
+{
+    ////////////////////////////////////////////////////////////
+    // SIMD offset blocks
+    //
+    // The branchless partitioning of pdqsort spends most of its
+    // time filling blocks of offsets of elements that are on the
+    // wrong side of the pivot, one element at a time. When those
+    // elements are arithmetic values compared with std::less<> or
+    // std::greater<>, a whole block of 64 elements is compared to
+    // the pivot with a few vector comparisons instead, giving a
+    // 64-bit mask of the elements to move. Every byte of that mask
+    // is then expanded to the offsets of its set bits with a table
+    // lookup, eight offsets at a time.
+
+    // Number of elements handled at once, one bit per element
+    constexpr std::size_t simd_block_size = 64;
+
+    template<typename T>
+    constexpr auto is_simd_partition_type()
+        -> bool
+    {
+        return (CPPSORT_AVX2_AVAILABLE || CPPSORT_AVX512F_AVAILABLE)
+            && std::is_arithmetic<T>::value
+            && not std::is_same<T, bool>::value
+            && (sizeof(T) == 4 || sizeof(T) == 8)
+            && (std::is_integral<T>::value
+                || std::is_same<T, float>::value
+                || std::is_same<T, double>::value);
+    }
+
+    template<typename Iterator, typename Compare, typename Projection>
+    constexpr auto use_simd_partition()
+        -> bool
+    {
+        using value_type = value_type_t<Iterator>;
+        return is_simd_partition_type<value_type>()
+            && simd_compare_order<Compare>::value != simd_order::unsupported
+            && is_identity_projection<Projection>::value
+            && is_contiguous_iterator<Iterator>::value;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Offset expansion tables
+
+    // For every possible byte, positions of its set bits packed
+    // as bytes in a 64-bit integer: in ascending bit order for
+    // the left block, and as distances to the end of the byte in
+    // descending bit order for the right block
+    struct offsets_tables
+    {
+        std::uint64_t left[256];
+        std::uint64_t right[256];
+        unsigned char counts[256];
+    };
+
+    constexpr auto make_offsets_tables()
+        -> offsets_tables
+    {
+        offsets_tables res = {};
+        for (unsigned mask = 0 ; mask < 256 ; ++mask) {
+            unsigned count = 0;
+            for (unsigned bit = 0 ; bit < 8 ; ++bit) {
+                if (mask & (1u << bit)) {
+                    res.left[mask] |= std::uint64_t(bit) << (8 * count);
+                    ++count;
+                }
+            }
+            count = 0;
+            for (unsigned bit = 8 ; bit-- > 0 ;) {
+                if (mask & (1u << bit)) {
+                    res.right[mask] |= std::uint64_t(8 - bit) << (8 * count);
+                    ++count;
+                }
+            }
+            res.counts[mask] = static_cast<unsigned char>(count);
+        }
+        return res;
+    }
+
+    template<typename=void>
+    struct offsets_tables_holder
+    {
+        static constexpr offsets_tables value = make_offsets_tables();
+    };
+
+    template<typename T>
+    constexpr offsets_tables offsets_tables_holder<T>::value;
+
+    // Writes the offsets of the elements whose bit is set in mask
+    // to offsets - which must have room for simd_block_size bytes
+    // - with the same layout as the scalar loops of pdqsort, and
+    // returns the number of such elements
+    inline auto expand_offsets_l(std::uint64_t mask, unsigned char* offsets)
+        -> std::size_t
+    {
+        constexpr auto& tables = offsets_tables_holder<>::value;
+
+        std::size_t num = 0;
+        for (std::uint64_t base = 0 ; base < simd_block_size ; base += 8) {
+            auto byte = static_cast<unsigned char>(mask);
+            // Add the base offset to every byte, the sums never overflow
+            std::uint64_t values = tables.left[byte] + base * 0x0101010101010101u;
+            std::memcpy(offsets + num, &values, sizeof(values));
+            num += tables.counts[byte];
+            mask >>= 8;
+        }
+        return num;
+    }
+
+    inline auto expand_offsets_r(std::uint64_t mask, unsigned char* offsets)
+        -> std::size_t
+    {
+        constexpr auto& tables = offsets_tables_holder<>::value;
+
+        std::size_t num = 0;
+        for (std::uint64_t base = 0 ; base < simd_block_size ; base += 8) {
+            // The right block is read backwards from its end
+            auto byte = static_cast<unsigned char>(mask >> (simd_block_size - 8 - base));
+            std::uint64_t values = tables.right[byte] + base * 0x0101010101010101u;
+            std::memcpy(offsets + num, &values, sizeof(values));
+            num += tables.counts[byte];
+        }
+        return num;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Comparison masks
+    //
+    // simd_compare_ops<T>::lt returns a mask whose bit i is set
+    // when the ith element of lhs compares less than the ith
+    // element of rhs, for every lane of the registers
+
+#if CPPSORT_AVX512F_AVAILABLE
+
+    template<typename T>
+    struct simd_compare_ops;
+
+    template<>
+    struct simd_compare_ops<std::int32_t>
+    {
+        using vector = __m512i;
+        static constexpr std::size_t lanes = 16;
+
+        static auto broadcast(std::int32_t value) -> vector { return _mm512_set1_epi32(value); }
+        static auto load(const std::int32_t* ptr) -> vector { return _mm512_loadu_si512(ptr); }
+        static auto lt(vector lhs, vector rhs) -> std::uint64_t { return _mm512_cmplt_epi32_mask(lhs, rhs); }
+    };
+
+    template<>
+    struct simd_compare_ops<std::uint32_t>
+    {
+        using vector = __m512i;
+        static constexpr std::size_t lanes = 16;
+
+        static auto broadcast(std::uint32_t value) -> vector { return _mm512_set1_epi32(static_cast<int>(value)); }
+        static auto load(const std::uint32_t* ptr) -> vector { return _mm512_loadu_si512(ptr); }
+        static auto lt(vector lhs, vector rhs) -> std::uint64_t { return _mm512_cmplt_epu32_mask(lhs, rhs); }
+    };
+
+    template<>
+    struct simd_compare_ops<std::int64_t>
+    {
+        using vector = __m512i;
+        static constexpr std::size_t lanes = 8;
+
+        static auto broadcast(std::int64_t value) -> vector { return _mm512_set1_epi64(value); }
+        static auto load(const std::int64_t* ptr) -> vector { return _mm512_loadu_si512(ptr); }
+        static auto lt(vector lhs, vector rhs) -> std::uint64_t { return _mm512_cmplt_epi64_mask(lhs, rhs); }
+    };
+
+    template<>
+    struct simd_compare_ops<std::uint64_t>
+    {
+        using vector = __m512i;
+        static constexpr std::size_t lanes = 8;
+
+        static auto broadcast(std::uint64_t value) -> vector { return _mm512_set1_epi64(static_cast<long long>(value)); }
+        static auto load(const std::uint64_t* ptr) -> vector { return _mm512_loadu_si512(ptr); }
+        static auto lt(vector lhs, vector rhs) -> std::uint64_t { return _mm512_cmplt_epu64_mask(lhs, rhs); }
+    };
+
+    template<>
+    struct simd_compare_ops<float>
+    {
+        using vector = __m512;
+        static constexpr std::size_t lanes = 16;
+
+        static auto broadcast(float value) -> vector { return _mm512_set1_ps(value); }
+        static auto load(const float* ptr) -> vector { return _mm512_loadu_ps(ptr); }
+        static auto lt(vector lhs, vector rhs) -> std::uint64_t { return _mm512_cmp_ps_mask(lhs, rhs, _CMP_LT_OQ); }
+    };
+
+    template<>
+    struct simd_compare_ops<double>
+    {
+        using vector = __m512d;
+        static constexpr std::size_t lanes = 8;
+
+        static auto broadcast(double value) -> vector { return _mm512_set1_pd(value); }
+        static auto load(const double* ptr) -> vector { return _mm512_loadu_pd(ptr); }
+        static auto lt(vector lhs, vector rhs) -> std::uint64_t { return _mm512_cmp_pd_mask(lhs, rhs, _CMP_LT_OQ); }
+    };
+
+#elif CPPSORT_AVX2_AVAILABLE
+
+    template<typename T>
+    struct simd_compare_ops;
+
+    template<>
+    struct simd_compare_ops<std::int32_t>
+    {
+        using vector = __m256i;
+        static constexpr std::size_t lanes = 8;
+
+        static auto broadcast(std::int32_t value) -> vector { return _mm256_set1_epi32(value); }
+        static auto load(const std::int32_t* ptr) -> vector
+        {
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+        }
+        static auto lt(vector lhs, vector rhs) -> std::uint64_t
+        {
+            return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(rhs, lhs))));
+        }
+    };
+
+    template<>
+    struct simd_compare_ops<std::uint32_t>
+    {
+        // Flip the sign bits to compare unsigned integers as signed ones
+        using vector = __m256i;
+        static constexpr std::size_t lanes = 8;
+
+        static auto broadcast(std::uint32_t value) -> vector
+        {
+            return _mm256_set1_epi32(static_cast<int>(value ^ 0x80000000u));
+        }
+        static auto load(const std::uint32_t* ptr) -> vector
+        {
+            return _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr)),
+                                    _mm256_set1_epi32(static_cast<int>(0x80000000u)));
+        }
+        static auto lt(vector lhs, vector rhs) -> std::uint64_t
+        {
+            return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(rhs, lhs))));
+        }
+    };
+
+    template<>
+    struct simd_compare_ops<std::int64_t>
+    {
+        using vector = __m256i;
+        static constexpr std::size_t lanes = 4;
+
+        static auto broadcast(std::int64_t value) -> vector { return _mm256_set1_epi64x(value); }
+        static auto load(const std::int64_t* ptr) -> vector
+        {
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+        }
+        static auto lt(vector lhs, vector rhs) -> std::uint64_t
+        {
+            return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(rhs, lhs))));
+        }
+    };
+
+    template<>
+    struct simd_compare_ops<std::uint64_t>
+    {
+        using vector = __m256i;
+        static constexpr std::size_t lanes = 4;
+
+        static auto broadcast(std::uint64_t value) -> vector
+        {
+            return _mm256_set1_epi64x(static_cast<long long>(value ^ 0x8000000000000000u));
+        }
+        static auto load(const std::uint64_t* ptr) -> vector
+        {
+            return _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr)),
+                                    _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000u)));
+        }
+        static auto lt(vector lhs, vector rhs) -> std::uint64_t
+        {
+            return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(rhs, lhs))));
+        }
+    };
+
+    template<>
+    struct simd_compare_ops<float>
+    {
+        using vector = __m256;
+        static constexpr std::size_t lanes = 8;
+
+        static auto broadcast(float value) -> vector { return _mm256_set1_ps(value); }
+        static auto load(const float* ptr) -> vector { return _mm256_loadu_ps(ptr); }
+        static auto lt(vector lhs, vector rhs) -> std::uint64_t
+        {
+            return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(lhs, rhs, _CMP_LT_OQ)));
+        }
+    };
+
+    template<>
+    struct simd_compare_ops<double>
+    {
+        using vector = __m256d;
+        static constexpr std::size_t lanes = 4;
+
+        static auto broadcast(double value) -> vector { return _mm256_set1_pd(value); }
+        static auto load(const double* ptr) -> vector { return _mm256_loadu_pd(ptr); }
+        static auto lt(vector lhs, vector rhs) -> std::uint64_t
+        {
+            return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(lhs, rhs, _CMP_LT_OQ)));
+        }
+    };
+
+#endif
+
+#if CPPSORT_AVX2_AVAILABLE || CPPSORT_AVX512F_AVAILABLE
+
+    // Integer types of a given size, regardless of how the
+    // standard library spells them
+    template<typename T>
+    using simd_compare_type = conditional_t<
+        std::is_floating_point<T>::value,
+        T,
+        conditional_t<
+            std::is_signed<T>::value,
+            conditional_t<sizeof(T) == 4, std::int32_t, std::int64_t>,
+            conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>
+        >
+    >;
+
+    // Mask of the elements x of [ptr, ptr + 64) for which
+    // compare(x, pivot) is true
+    template<simd_order Order, typename T>
+    auto compare_mask(const T* ptr, T pivot)
+        -> std::uint64_t
+    {
+        using ops = simd_compare_ops<simd_compare_type<T>>;
+        using U = simd_compare_type<T>;
+        auto data = reinterpret_cast<const U*>(ptr);
+        auto vpivot = ops::broadcast(static_cast<U>(pivot));
+
+        std::uint64_t mask = 0;
+        for (std::size_t idx = 0 ; idx < simd_block_size ; idx += ops::lanes) {
+            auto values = ops::load(data + idx);
+            std::uint64_t res = Order == simd_order::ascending ?
+                ops::lt(values, vpivot) :
+                ops::lt(vpivot, values);
+            mask |= res << idx;
+        }
+        return mask;
+    }
+
+    // Fill a whole offsets block with the elements of [first, first + 64)
+    // not comparing less than the pivot, returns the number of offsets
+    template<simd_order Order, typename RandomAccessIterator, typename T>
+    auto simd_fill_offsets_l(RandomAccessIterator first, const T& pivot, unsigned char* offsets)
+        -> std::size_t
+    {
+        auto mask = compare_mask<Order>(std::addressof(*first), pivot);
+        return expand_offsets_l(~mask, offsets);
+    }
+
+    // Fill a whole offsets block with the elements of [last - 64, last)
+    // comparing less than the pivot, returns the number of offsets
+    template<simd_order Order, typename RandomAccessIterator, typename T>
+    auto simd_fill_offsets_r(RandomAccessIterator last, const T& pivot, unsigned char* offsets)
+        -> std::size_t
+    {
+        using difference_type = difference_type_t<RandomAccessIterator>;
+        auto block = last - static_cast<difference_type>(simd_block_size);
+        auto mask = compare_mask<Order>(std::addressof(*block), pivot);
+        return expand_offsets_r(mask, offsets);
+    }
+
+#endif
+}}}
+
+#endif // CPPSORT_DETAIL_PDQSORT_SIMD_H_
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_SCRATCH_MEMORY_H_
+#define CPPSORT_DETAIL_SCRATCH_MEMORY_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <new>
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Scratch memory
+    //
+    // Several adapters and measures of presortedness allocate a
+    // temporary buffer of iterators or values every time they
+    // are called, which makes the memory allocator show up in
+    // profiles when they are called in a loop on many small
+    // collections. To mitigate this, every thread keeps a few
+    // small blocks of memory released by such buffers instead of
+    // returning them to the allocator, and reuses them for the
+    // next buffers of the same size class. At most max_blocks
+    // blocks of max_block_size bytes, 256 KiB in total, are kept
+    // alive by every thread until it exits.
+    //
+    // Once the cache of a thread has been destroyed, which can
+    // happen before the destruction of other thread_local objects
+    // that still sort collections, the memory comes straight
+    // from ::operator new and goes back to ::operator delete.
+    //
+    // The cache can be disabled by defining the preprocessor
+    // macro CPPSORT_DISABLE_SCRATCH_CACHE.
+
+    class scratch_cache
+    {
+        public:
+
+            // Number of blocks kept by every thread
+            static constexpr std::size_t max_blocks = 4;
+
+            // Bigger blocks are always returned to the allocator
+            static constexpr std::size_t max_block_size = 1 << 16;
+
+            // Smallest size class
+            static constexpr std::size_t min_block_size = 64;
+
+            scratch_cache() = default;
+            scratch_cache(const scratch_cache&) = delete;
+            scratch_cache& operator=(const scratch_cache&) = delete;
+
+            ~scratch_cache()
+            {
+                destroyed() = true;
+                for (auto& block: blocks_) {
+                    if (block.memory != nullptr) {
+                        deallocate_block(block.memory, block.size);
+                        block.memory = nullptr;
+                    }
+                }
+            }
+
+            static auto instance()
+                -> scratch_cache&
+            {
+                thread_local scratch_cache cache;
+                return cache;
+            }
+
+            // Whether the cache of the current thread was destroyed:
+            // the flag is trivially destructible, so it can still be
+            // read after the cache itself is gone
+            static auto destroyed() noexcept
+                -> bool&
+            {
+                thread_local bool res = false;
+                return res;
+            }
+
+            // Size of the block actually allocated for a given
+            // number of bytes: small sizes are rounded up to the
+            // next power of 2 so that blocks can be reused for
+            // buffers of slightly different sizes
+            static constexpr auto block_size(std::size_t size) noexcept
+                -> std::size_t
+            {
+                return size > max_block_size ? size : round_up(size, min_block_size);
+            }
+
+            // The following functions take sizes already rounded
+            // with block_size()
+
+            auto allocate(std::size_t size)
+                -> void*
+            {
+                for (auto& block: blocks_) {
+                    if (block.memory != nullptr && block.size == size) {
+                        void* res = block.memory;
+                        block.memory = nullptr;
+                        return res;
+                    }
+                }
+                return ::operator new(size);
+            }
+
+            auto deallocate(void* memory, std::size_t size) noexcept
+                -> void
+            {
+                if (size > max_block_size) {
+                    deallocate_block(memory, size);
+                    return;
+                }
+
+                for (auto& block: blocks_) {
+                    if (block.memory == nullptr) {
+                        block = { memory, size };
+                        return;
+                    }
+                }
+
+                // Every slot is taken, evict them in a round-robin fashion
+                auto& block = blocks_[next_eviction_];
+                deallocate_block(block.memory, block.size);
+                block = { memory, size };
+                next_eviction_ = (next_eviction_ + 1) % max_blocks;
+            }
+
+            static auto deallocate_block(void* memory, std::size_t size) noexcept
+                -> void
+            {
+#ifdef __cpp_sized_deallocation
+                ::operator delete(memory, size);
+#else
+                (void)size;
+                ::operator delete(memory);
+#endif
+            }
+
+        private:
+
+            struct block_type
+            {
+                void* memory;
+                std::size_t size;
+            };
+
+            static constexpr auto round_up(std::size_t size, std::size_t res) noexcept
+                -> std::size_t
+            {
+                return res >= size ? res : round_up(size, res * 2);
+            }
+
+            block_type blocks_[max_blocks] = {};
+            std::size_t next_eviction_ = 0;
+    };
+
+    // Allocates memory for a temporary buffer of size bytes, the
+    // memory must be released with deallocate_scratch with the
+    // same size; the size is rounded the same way whether the
+    // cache is used or not, so that memory allocated through the
+    // cache can be released after its destruction
+
+    inline auto allocate_scratch(std::size_t size)
+        -> void*
+    {
+        size = scratch_cache::block_size(size);
+#ifndef CPPSORT_DISABLE_SCRATCH_CACHE
+        if (not scratch_cache::destroyed()) {
+            return scratch_cache::instance().allocate(size);
+        }
+#endif
+        return ::operator new(size);
+    }
+
+    inline auto deallocate_scratch(void* memory, std::size_t size) noexcept
+        -> void
+    {
+        size = scratch_cache::block_size(size);
+#ifndef CPPSORT_DISABLE_SCRATCH_CACHE
+        if (not scratch_cache::destroyed()) {
+            scratch_cache::instance().deallocate(memory, size);
+            return;
+        }
+#endif
+        scratch_cache::deallocate_block(memory, size);
+    }
+}}
+
+#endif // CPPSORT_DETAIL_SCRATCH_MEMORY_H_
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_SIMD_TRAITS_H_
+#define CPPSORT_DETAIL_SIMD_TRAITS_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <functional>
+#include <type_traits>
+#include <cpp-sort/utility/functional.h>
+#include "config.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Common traits for SIMD code paths
+    //
+    // SIMD kernels only replace the scalar algorithms when the
+    // comparison they perform is known in advance, which means
+    // that the elements are compared directly - without any
+    // projection - with one of the standard comparison function
+    // objects.
+
+    // Whether a comparison orders elements in ascending order,
+    // descending order, or in a way SIMD kernels can't handle
+    enum struct simd_order
+    {
+        unsupported,
+        ascending,
+        descending
+    };
+
+    template<typename Compare>
+    struct simd_compare_order:
+        std::integral_constant<simd_order, simd_order::unsupported>
+    {};
+
+    template<>
+    struct simd_compare_order<std::less<>>:
+        std::integral_constant<simd_order, simd_order::ascending>
+    {};
+
+    template<>
+    struct simd_compare_order<std::greater<>>:
+        std::integral_constant<simd_order, simd_order::descending>
+    {};
+
+#ifdef __cpp_lib_ranges
+    template<>
+    struct simd_compare_order<std::ranges::less>:
+        std::integral_constant<simd_order, simd_order::ascending>
+    {};
+
+    template<>
+    struct simd_compare_order<std::ranges::greater>:
+        std::integral_constant<simd_order, simd_order::descending>
+    {};
+#endif
+
+    template<typename Projection>
+    struct is_identity_projection:
+        std::is_same<Projection, utility::identity>
+    {};
+
+#if CPPSORT_STD_IDENTITY_AVAILABLE
+    template<>
+    struct is_identity_projection<std::identity>:
+        std::true_type
+    {};
+#endif
+}}
+
+#endif // CPPSORT_DETAIL_SIMD_TRAITS_H_
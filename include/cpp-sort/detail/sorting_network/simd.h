@@ -0,0 +1,402 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_SORTING_NETWORK_SIMD_H_
+#define CPPSORT_DETAIL_SORTING_NETWORK_SIMD_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "../config.h"
+#include "../iterator_traits.h"
+#include "../simd_traits.h"
+#include "../type_traits.h"
+
+#if CPPSORT_AVX512F_AVAILABLE
+#   include <immintrin.h>
+#endif
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // SIMD sorting networks
+    //
+    // When the elements to sort are 32-bit integers or floating
+    // point numbers compared with a plain std::less<> or with
+    // std::greater<>, a sorting network can be executed entirely
+    // in one or two AVX-512 registers: the comparators are grouped
+    // into layers of comparators operating on disjoint elements,
+    // and each layer is performed by permuting every element to
+    // its partner's position, computing the element-wise min and
+    // max, then blending them so that the first element of every
+    // pair receives the min and the second one receives the max.
+    //
+    // The permutations are computed at compile time from the
+    // index_pairs() of the network. Narrower registers and 64-bit
+    // elements were also considered, but the latency of the
+    // permutations makes such kernels slower than the branchless
+    // swap_if specializations when there are fewer elements per
+    // register.
+    //
+    // The kernels give the same results as the scalar networks for
+    // integers. They can differ for floating point numbers: -0.0
+    // and +0.0 are equivalent, and when a comparator receives both
+    // the branchless swap_if can write the same zero to both of
+    // its outputs while the vector min and max keep one of each.
+
+    namespace simd_network_detail
+    {
+        // Smaller networks are cheap enough to run with swap_if
+        constexpr std::size_t min_size = 8;
+
+        // Number of 32-bit lanes in an AVX-512 register
+        constexpr std::size_t reg_lanes = 16;
+
+        template<typename T, std::size_t N>
+        constexpr auto is_kernel_available()
+            -> bool
+        {
+            return CPPSORT_AVX512F_AVAILABLE
+                && N >= min_size
+                && N <= 2 * reg_lanes
+                && ((std::is_same<T, float>::value && sizeof(T) == 4)
+                    || (std::is_integral<T>::value && std::is_signed<T>::value
+                        && sizeof(T) == 4));
+        }
+
+        template<std::size_t N, typename Iterator, typename Compare, typename Projection>
+        constexpr auto use_kernel()
+            -> bool
+        {
+            using value_type = value_type_t<Iterator>;
+            return std::is_same<reference_t<Iterator>, value_type&>::value
+                && simd_compare_order<Compare>::value != simd_order::unsupported
+                && is_identity_projection<Projection>::value
+                && is_kernel_available<value_type, N>();
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Compile-time permutation tables
+
+        // Every comparator is scheduled in the layer following the
+        // last layer touching any of its elements, which does not
+        // change the result since comparators operating on disjoint
+        // elements commute
+        template<typename Network, std::size_t N>
+        constexpr auto network_depth()
+            -> std::size_t
+        {
+            const auto pairs = Network::template index_pairs<std::size_t>();
+            std::size_t depth[N] = {};
+            std::size_t res = 0;
+            for (std::size_t idx = 0 ; idx < pairs.size() ; ++idx) {
+                auto layer = (std::max)(depth[pairs[idx].first], depth[pairs[idx].second]) + 1;
+                depth[pairs[idx].first] = layer;
+                depth[pairs[idx].second] = layer;
+                res = (std::max)(res, layer);
+            }
+            return res;
+        }
+
+        template<typename Network, std::size_t N>
+        struct network_layout
+        {
+            static constexpr std::size_t nb_regs = (N + reg_lanes - 1) / reg_lanes;
+            static constexpr std::size_t nb_layers = network_depth<Network, N>();
+        };
+
+        template<std::size_t NbLayers, std::size_t NbRegs>
+        struct network_tables
+        {
+            // Indices of the lanes holding the partners of the elements,
+            // the fifth bit selecting the second register
+            std::int32_t indices[NbLayers][NbRegs][reg_lanes];
+            // Lanes holding the second element of their pair
+            std::uint32_t seconds[NbLayers][NbRegs];
+        };
+
+        template<typename Network, std::size_t N>
+        using network_tables_t = network_tables<
+            network_layout<Network, N>::nb_layers,
+            network_layout<Network, N>::nb_regs
+        >;
+
+        template<typename Network, std::size_t N>
+        constexpr auto make_network_tables()
+            -> network_tables_t<Network, N>
+        {
+            using layout = network_layout<Network, N>;
+            constexpr std::size_t nb_layers = layout::nb_layers;
+            constexpr std::size_t nb_lanes = layout::nb_regs * reg_lanes;
+
+            // Partner of every element in every layer, elements
+            // without partner being their own partner
+            std::size_t partners[nb_layers][nb_lanes] = {};
+            for (std::size_t layer = 0 ; layer < nb_layers ; ++layer) {
+                for (std::size_t idx = 0 ; idx < nb_lanes ; ++idx) {
+                    partners[layer][idx] = idx;
+                }
+            }
+            const auto pairs = Network::template index_pairs<std::size_t>();
+            std::size_t depth[N] = {};
+            for (std::size_t idx = 0 ; idx < pairs.size() ; ++idx) {
+                auto lhs = pairs[idx].first;
+                auto rhs = pairs[idx].second;
+                auto layer = (std::max)(depth[lhs], depth[rhs]);
+                partners[layer][lhs] = rhs;
+                partners[layer][rhs] = lhs;
+                depth[lhs] = layer + 1;
+                depth[rhs] = layer + 1;
+            }
+
+            network_tables_t<Network, N> res = {};
+            for (std::size_t layer = 0 ; layer < nb_layers ; ++layer) {
+                for (std::size_t idx = 0 ; idx < nb_lanes ; ++idx) {
+                    auto partner = partners[layer][idx];
+                    res.indices[layer][idx / reg_lanes][idx % reg_lanes] = static_cast<std::int32_t>(partner);
+                    if (partner < idx) {
+                        res.seconds[layer][idx / reg_lanes] |= std::uint32_t(1) << (idx % reg_lanes);
+                    }
+                }
+            }
+            return res;
+        }
+
+        template<typename Network, std::size_t N>
+        struct network_tables_holder
+        {
+            static constexpr network_tables_t<Network, N> value
+                = make_network_tables<Network, N>();
+        };
+
+        template<typename Network, std::size_t N>
+        constexpr network_tables_t<Network, N> network_tables_holder<Network, N>::value;
+
+#if CPPSORT_AVX512F_AVAILABLE
+        ////////////////////////////////////////////////////////////
+        // Vector operations
+        //
+        // The elements are always held in integer registers and
+        // reinterpreted when floating point operations are needed
+
+        struct vector_ops_base
+        {
+            using reg = __m512i;
+
+            // Only the lanes in mask are read or written, which allows
+            // to work directly with collections that don't fill whole
+            // registers
+
+            static auto load(const void* ptr, std::uint32_t mask) noexcept
+                -> reg
+            {
+                return _mm512_maskz_loadu_epi32(static_cast<__mmask16>(mask), ptr);
+            }
+
+            static auto store(void* ptr, std::uint32_t mask, reg value) noexcept
+                -> void
+            {
+                _mm512_mask_storeu_epi32(ptr, static_cast<__mmask16>(mask), value);
+            }
+
+            static auto permute(reg value, const std::int32_t* indices) noexcept
+                -> reg
+            {
+                return _mm512_permutexvar_epi32(_mm512_loadu_si512(indices), value);
+            }
+
+            static auto permute(reg lhs, reg rhs, const std::int32_t* indices) noexcept
+                -> reg
+            {
+                return _mm512_permutex2var_epi32(lhs, _mm512_loadu_si512(indices), rhs);
+            }
+
+            static auto select(reg firsts, reg seconds, std::uint32_t mask) noexcept
+                -> reg
+            {
+                return _mm512_mask_blend_epi32(static_cast<__mmask16>(mask), firsts, seconds);
+            }
+        };
+
+        template<typename T>
+        struct vector_ops:
+            vector_ops_base
+        {
+            static auto min(reg lhs, reg rhs) noexcept -> reg { return _mm512_min_epi32(lhs, rhs); }
+            static auto max(reg lhs, reg rhs) noexcept -> reg { return _mm512_max_epi32(lhs, rhs); }
+        };
+
+        template<>
+        struct vector_ops<float>:
+            vector_ops_base
+        {
+            static auto min(reg lhs, reg rhs) noexcept
+                -> reg
+            {
+                return _mm512_castps_si512(_mm512_min_ps(_mm512_castsi512_ps(lhs), _mm512_castsi512_ps(rhs)));
+            }
+
+            static auto max(reg lhs, reg rhs) noexcept
+                -> reg
+            {
+                return _mm512_castps_si512(_mm512_max_ps(_mm512_castsi512_ps(lhs), _mm512_castsi512_ps(rhs)));
+            }
+        };
+
+        ////////////////////////////////////////////////////////////
+        // Network kernel
+        //
+        // Sorts the N elements of data, the layers are unrolled so
+        // that the elements never leave the registers
+
+        template<typename Network, std::size_t N, simd_order Order, typename T>
+        struct network_kernel
+        {
+            using ops = vector_ops<T>;
+            using layout = network_layout<Network, N>;
+            using tables = network_tables_holder<Network, N>;
+            using reg = typename ops::reg;
+
+            // Mask of the lanes of the register idx holding elements
+            static constexpr auto lanes_mask(std::size_t idx)
+                -> std::uint32_t
+            {
+                return N >= (idx + 1) * reg_lanes ?
+                    0xFFFFu :
+                    (std::uint32_t(1) << (N - idx * reg_lanes)) - 1;
+            }
+
+            template<std::size_t Layer, std::size_t Idx>
+            static auto compare_exchange(reg value, reg partner) noexcept
+                -> reg
+            {
+                // The partner always comes first so that elements comparing
+                // equivalent stay in place, just like with swap_if
+                auto mins = ops::min(partner, value);
+                auto maxs = ops::max(partner, value);
+                return ops::select(
+                    Order == simd_order::ascending ? mins : maxs,
+                    Order == simd_order::ascending ? maxs : mins,
+                    tables::value.seconds[Layer][Idx]
+                );
+            }
+
+            template<std::size_t Layer>
+            static auto run_layer(reg& value) noexcept
+                -> void
+            {
+                auto partner = ops::permute(value, tables::value.indices[Layer][0]);
+                value = compare_exchange<Layer, 0>(value, partner);
+            }
+
+            template<std::size_t Layer>
+            static auto run_layer(reg& lhs, reg& rhs) noexcept
+                -> void
+            {
+                auto lhs_partner = ops::permute(lhs, rhs, tables::value.indices[Layer][0]);
+                auto rhs_partner = ops::permute(lhs, rhs, tables::value.indices[Layer][1]);
+                lhs = compare_exchange<Layer, 0>(lhs, lhs_partner);
+                rhs = compare_exchange<Layer, 1>(rhs, rhs_partner);
+            }
+
+            template<std::size_t... Layers>
+            static auto sort(T* data, std::integral_constant<std::size_t, 1>,
+                             std::index_sequence<Layers...>) noexcept
+                -> void
+            {
+                reg value = ops::load(data, lanes_mask(0));
+                int dummy[] = { 0, (run_layer<Layers>(value), 0)... };
+                (void) dummy;
+                ops::store(data, lanes_mask(0), value);
+            }
+
+            template<std::size_t... Layers>
+            static auto sort(T* data, std::integral_constant<std::size_t, 2>,
+                             std::index_sequence<Layers...>) noexcept
+                -> void
+            {
+                reg lhs = ops::load(data, lanes_mask(0));
+                reg rhs = ops::load(data + reg_lanes, lanes_mask(1));
+                int dummy[] = { 0, (run_layer<Layers>(lhs, rhs), 0)... };
+                (void) dummy;
+                ops::store(data, lanes_mask(0), lhs);
+                ops::store(data + reg_lanes, lanes_mask(1), rhs);
+            }
+
+            static auto sort(T* data) noexcept
+                -> void
+            {
+                sort(data, std::integral_constant<std::size_t, layout::nb_regs>{},
+                     std::make_index_sequence<layout::nb_layers>{});
+            }
+        };
+#endif
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Sort a fixed-size collection with a sorting network,
+    // using a SIMD kernel when possible
+
+    template<
+        std::size_t N,
+        typename Network,
+        typename RandomAccessIterator,
+        typename Compare,
+        typename Projection
+    >
+    auto sort_network_simd(Network network, RandomAccessIterator first, RandomAccessIterator last,
+                           Compare compare, Projection projection)
+        -> detail::enable_if_t<
+            not simd_network_detail::use_kernel<N, RandomAccessIterator, Compare, Projection>()
+        >
+    {
+        network(std::move(first), std::move(last), std::move(compare), std::move(projection));
+    }
+
+#if CPPSORT_AVX512F_AVAILABLE
+    template<
+        std::size_t N,
+        typename Network,
+        typename RandomAccessIterator,
+        typename Compare,
+        typename Projection
+    >
+    auto sort_network_simd(Network, RandomAccessIterator first, RandomAccessIterator,
+                           Compare, Projection)
+        -> detail::enable_if_t<
+            simd_network_detail::use_kernel<N, RandomAccessIterator, Compare, Projection>()
+        >
+    {
+        using namespace simd_network_detail;
+        using difference_type = difference_type_t<RandomAccessIterator>;
+        using value_type = value_type_t<RandomAccessIterator>;
+        using kernel = network_kernel<Network, N, simd_compare_order<Compare>::value, value_type>;
+
+        if (std::is_pointer<RandomAccessIterator>::value) {
+            kernel::sort(std::addressof(*first));
+            return;
+        }
+
+        // The elements of other iterators might not be contiguous
+        value_type buffer[N];
+        for (std::size_t idx = 0 ; idx < N ; ++idx) {
+            buffer[idx] = first[static_cast<difference_type>(idx)];
+        }
+        kernel::sort(buffer);
+        for (std::size_t idx = 0 ; idx < N ; ++idx) {
+            first[static_cast<difference_type>(idx)] = buffer[idx];
+        }
+    }
+#endif
+}}
+
+#endif // CPPSORT_DETAIL_SORTING_NETWORK_SIMD_H_
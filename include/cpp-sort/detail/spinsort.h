@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2021 Morwenn
+ * Copyright (c) 2019-2022 Morwenn
  * SPDX-License-Identifier: MIT
  */
 
@@ -312,31 +312,69 @@ namespace detail
                 spinsort(RandomAccessIterator first, RandomAccessIterator last,
                          Compare compare, Projection projection)
                 {
-                    using utility::iter_move;
-
-                    range<RandomAccessIterator> range_input(first, last);
-                    CPPSORT_ASSERT(range_input.valid());
-
-                    auto size = range_input.size();
+                    auto size = last - first;
                     if (size <= Sort_min * 2) {
-                        insertion_sort(range_input.first, range_input.last,
+                        insertion_sort(std::move(first), std::move(last),
                                        std::move(compare), std::move(projection));
                         return;
                     }
 
-                    auto nelem_1 = (size + 1) / 2;
-                    auto nelem_2 = size - nelem_1;
-
                     // Buffer used by the merge operations
-                    auto buffer_size = nelem_1;
+                    auto buffer_size = (size + 1) / 2;
                     std::unique_ptr<rvalue_type, operator_deleter> buffer(
                         static_cast<rvalue_type*>(::operator new(buffer_size * sizeof(rvalue_type))),
                         operator_deleter(buffer_size * sizeof(rvalue_type))
                     );
-                    range_buf range_aux(buffer.get(), (buffer.get() + buffer_size));
+                    sort(std::move(first), std::move(last),
+                         std::move(compare), std::move(projection),
+                         buffer.get());
+                }
+
+                //-------------------------------------------------------------------------
+                //  function : spinsort
+                // @brief constructor
+                //
+                // @param first : iterator to the first element of the range to sort
+                // @param last : iterator after the last element to the range to sort
+                // @param compare : object for to compare two elements pointed by RandomAccessIterator
+                //                  iterators
+                // @param projection : projection object
+                // @param buffer : uninitialized memory able to hold at least
+                //                 (last - first + 1) / 2 elements
+                //------------------------------------------------------------------------
+                spinsort(RandomAccessIterator first, RandomAccessIterator last,
+                         Compare compare, Projection projection,
+                         rvalue_type* buffer)
+                {
+                    auto size = last - first;
+                    if (size <= Sort_min * 2) {
+                        insertion_sort(std::move(first), std::move(last),
+                                       std::move(compare), std::move(projection));
+                        return;
+                    }
+                    sort(std::move(first), std::move(last),
+                         std::move(compare), std::move(projection),
+                         buffer);
+                }
+
+            private:
+
+                static auto sort(RandomAccessIterator first, RandomAccessIterator last,
+                                 Compare compare, Projection projection,
+                                 rvalue_type* buffer)
+                    -> void
+                {
+                    range<RandomAccessIterator> range_input(first, last);
+                    CPPSORT_ASSERT(range_input.valid());
+
+                    auto size = range_input.size();
+                    auto nelem_1 = (size + 1) / 2;
+                    auto nelem_2 = size - nelem_1;
+
+                    range_buf range_aux(buffer, buffer + nelem_1);
 
                     destruct_n<rvalue_type> d(0);
-                    std::unique_ptr<rvalue_type, destruct_n<rvalue_type>&> h2(buffer.get(), d);
+                    std::unique_ptr<rvalue_type, destruct_n<rvalue_type>&> h2(buffer, d);
 
                     //---------------------------------------------------------------------
                     //                  Process
@@ -396,6 +434,19 @@ namespace detail
             std::move(compare), std::move(projection)
         );
     }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto spinsort(RandomAccessIterator first, RandomAccessIterator last,
+                  Compare compare, Projection projection,
+                  rvalue_type_t<RandomAccessIterator>* buffer)
+        -> void
+    {
+        spin_detail::spinsort<RandomAccessIterator, Compare, Projection>(
+            std::move(first), std::move(last),
+            std::move(compare), std::move(projection),
+            buffer
+        );
+    }
 }}
 
 #endif // CPPSORT_DETAIL_SPINSORT_H_
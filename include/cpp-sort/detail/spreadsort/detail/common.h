@@ -24,6 +24,7 @@ Phil Endecott and Frank Gennari
 // Headers
 ////////////////////////////////////////////////////////////
 #include <cstddef>
+#include <memory>
 #include <vector>
 #include "constants.h"
 #include "../../type_traits.h"
@@ -128,6 +129,36 @@ namespace detail
         bin_cache.resize(cache_end);
       return &(bin_cache[cache_offset]);
     }
+
+    // Holds the sizes of the bins: they are kept on the stack as long
+    // as they fit in a few dozen KiB, and allocated on the heap for
+    // bigger values of max_splits, which would otherwise overflow the
+    // stack - notably the smaller stacks of worker threads
+    template<bool OnStack = (max_finishing_splits <= max_stack_finishing_splits)>
+    struct bin_sizes_buffer
+    {
+      std::size_t bin_sizes[std::size_t(1) << max_finishing_splits];
+
+      auto get()
+          -> std::size_t*
+      {
+        return bin_sizes;
+      }
+    };
+
+    template<>
+    struct bin_sizes_buffer<false>
+    {
+      std::unique_ptr<std::size_t[]> bin_sizes{
+        new std::size_t[std::size_t(1) << max_finishing_splits]
+      };
+
+      auto get()
+          -> std::size_t*
+      {
+        return bin_sizes.get();
+      }
+    };
 }}}}
 
 #endif // CPPSORT_DETAIL_SPREADSORT_DETAIL_COMMON_H_
@@ -15,6 +15,18 @@
 #ifndef CPPSORT_DETAIL_SPREADSORT_DETAIL_CONSTANTS_H_
 #define CPPSORT_DETAIL_SPREADSORT_DETAIL_CONSTANTS_H_
 
+// The most machine-dependent constants can be tuned by
+// defining the following macros
+#ifndef CPPSORT_SPREADSORT_MAX_SPLITS
+#   define CPPSORT_SPREADSORT_MAX_SPLITS 11
+#endif
+static_assert(CPPSORT_SPREADSORT_MAX_SPLITS >= 9 && CPPSORT_SPREADSORT_MAX_SPLITS <= 20,
+              "CPPSORT_SPREADSORT_MAX_SPLITS must be between 9 and 20");
+
+#ifndef CPPSORT_SPREADSORT_MIN_SORT_SIZE
+#   define CPPSORT_SPREADSORT_MIN_SORT_SIZE 1000
+#endif
+
 namespace cppsort
 {
 namespace detail
@@ -29,10 +41,12 @@ namespace detail
         //if you go too large you get cache misses on bins
         //The smaller this number, the less worst-case memory usage.
         //If too small, too many recursions slow down spreadsort
-        max_splits = 11,
+        max_splits = CPPSORT_SPREADSORT_MAX_SPLITS,
         //It's better to have a few cache misses and finish sorting
         //than to run another iteration
         max_finishing_splits = max_splits + 1,
+        //Bigger bin sizes arrays are allocated on the heap
+        max_stack_finishing_splits = 12,
         //Sets the minimum number of items per bin.
         int_log_mean_bin_size = 2,
         //Used to force a comparison-based sorting for small bins, if it's faster.
@@ -50,7 +64,7 @@ namespace detail
         //iteration.  Make this larger the faster std::sort is relative to float_sort.
         float_log_finishing_count = 4,
         //There is a minimum size below which it is not worth using spreadsort
-        min_sort_size = 1000
+        min_sort_size = CPPSORT_SPREADSORT_MIN_SORT_SIZE
     };
 }}}}
 
@@ -370,10 +370,10 @@ namespace detail
             void
         >
     {
-      std::size_t bin_sizes[1 << max_finishing_splits];
+      bin_sizes_buffer<> bin_sizes;
       std::vector<RandomAccessIter> bin_cache;
       float_sort_rec<RandomAccessIter, std::int32_t, std::uint32_t>
-        (first, last, bin_cache, 0, bin_sizes, projection);
+        (first, last, bin_cache, 0, bin_sizes.get(), projection);
     }
 
     //Checking whether the value type is a double, and using a 64-bit integer
@@ -385,10 +385,10 @@ namespace detail
             void
         >
     {
-      std::size_t bin_sizes[1 << max_finishing_splits];
+      bin_sizes_buffer<> bin_sizes;
       std::vector<RandomAccessIter> bin_cache;
       float_sort_rec<RandomAccessIter, std::int64_t, std::uint64_t>
-        (first, last, bin_cache, 0, bin_sizes, projection);
+        (first, last, bin_cache, 0, bin_sizes.get(), projection);
     }
 }}}}
 
@@ -208,10 +208,10 @@ namespace spreadsort
             void
         >
     {
-      std::size_t bin_sizes[1 << max_finishing_splits];
+      bin_sizes_buffer<> bin_sizes;
       std::vector<RandomAccessIter> bin_cache;
       spreadsort_rec<RandomAccessIter, Div_type, std::size_t, Projection>(
-          first, last, bin_cache, 0, bin_sizes, projection);
+          first, last, bin_cache, 0, bin_sizes.get(), projection);
     }
 
     //Holds the bin vector and makes the initial recursive call
@@ -225,10 +225,10 @@ namespace spreadsort
             void
         >
     {
-      std::size_t bin_sizes[1 << max_finishing_splits];
+      bin_sizes_buffer<> bin_sizes;
       std::vector<RandomAccessIter> bin_cache;
       spreadsort_rec<RandomAccessIter, Div_type, std::uintmax_t, Projection>(
-          first, last, bin_cache, 0, bin_sizes, projection);
+          first, last, bin_cache, 0, bin_sizes.get(), projection);
     }
   }
 }}}
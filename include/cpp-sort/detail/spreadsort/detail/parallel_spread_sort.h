@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_SPREADSORT_DETAIL_PARALLEL_SPREAD_SORT_H_
+#define CPPSORT_DETAIL_SPREADSORT_DETAIL_PARALLEL_SPREAD_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/iter_move.h>
+#include "common.h"
+#include "constants.h"
+#include "float_sort.h"
+#include "integer_sort.h"
+#include "../../iterator_traits.h"
+#include "../../memcpy_cast.h"
+#include "../../memory.h"
+#include "../../move.h"
+#include "../../pdqsort.h"
+#include "../../thread_pool.h"
+#include "../../type_traits.h"
+
+namespace cppsort
+{
+namespace detail
+{
+namespace spreadsort
+{
+  namespace detail {
+    ////////////////////////////////////////////////////////////
+    // Parallel integer_sort and float_sort
+    //
+    // Every value is mapped to an unsigned key whose order is the
+    // same as the order of the values, which allows integers and
+    // floating point numbers to share the same parallel passes.
+    // The collection is cut into one chunk per thread, and every
+    // chunk computes the extremes of its keys concurrently; the
+    // number of bits used to bin the keys is then computed like
+    // in the sequential algorithm. Every chunk computes the
+    // histogram of its keys, and scatters its elements to a buffer
+    // at offsets computed from the prefix sums of all histograms,
+    // before the bins are moved back to the collection. Every bin
+    // is then sorted in its own task, either with another parallel
+    // pass if it is still big enough, or with the sequential
+    // algorithm.
+
+    namespace parallel_spread_sort_detail
+    {
+        enum {
+            // Below this size, bins are sorted sequentially
+            min_parallel_size = 1 << 16,
+
+            // Minimum number of elements handled by a single task
+            // during a parallel pass
+            min_chunk_size = 1 << 14
+        };
+
+        template<typename T>
+        using integer_key_t = std::conditional_t<
+            sizeof(T) <= sizeof(std::uint32_t),
+            std::uint32_t,
+            std::uintmax_t
+        >;
+
+        template<typename T>
+        using float_key_t = std::conditional_t<
+            sizeof(T) == sizeof(std::uint32_t),
+            std::uint32_t,
+            std::uint64_t
+        >;
+
+        // Offset the integers so that the smallest value of the
+        // type is mapped to 0, unsigned arithmetic takes care of
+        // the wrap-around
+        template<typename Projection>
+        struct integer_key
+        {
+            Projection projection;
+
+            template<typename T>
+            auto operator()(T&& value) const
+                -> integer_key_t<remove_cvref_t<invoke_result_t<Projection, T>>>
+            {
+                auto&& proj = utility::as_function(projection);
+                using value_type = remove_cvref_t<invoke_result_t<Projection, T>>;
+                using key_type = integer_key_t<value_type>;
+                return static_cast<key_type>(proj(std::forward<T>(value)))
+                     - static_cast<key_type>((std::numeric_limits<value_type>::min)());
+            }
+        };
+
+        // Flip the sign bit of positive numbers and all the bits
+        // of negative numbers, which orders the negative numbers
+        // before the positive ones and reverses their order
+        template<typename Projection>
+        struct float_key
+        {
+            Projection projection;
+
+            template<typename T>
+            auto operator()(T&& value) const
+                -> float_key_t<remove_cvref_t<invoke_result_t<Projection, T>>>
+            {
+                auto&& proj = utility::as_function(projection);
+                using key_type = float_key_t<remove_cvref_t<invoke_result_t<Projection, T>>>;
+                constexpr key_type sign_bit = key_type(1) << (sizeof(key_type) * 8 - 1);
+                auto bits = memcpy_cast<key_type>(proj(std::forward<T>(value)));
+                return (bits & sign_bit) ? key_type(~bits) : key_type(bits | sign_bit);
+            }
+        };
+
+        template<typename RandomAccessIter, typename KeyFunction, typename SequentialSort>
+        auto sort(RandomAccessIter first, RandomAccessIter last,
+                  rvalue_type_t<RandomAccessIter>* buffer,
+                  KeyFunction key, SequentialSort sequential_sort)
+            -> void
+        {
+          using difference_type = difference_type_t<RandomAccessIter>;
+          using rvalue_type = rvalue_type_t<RandomAccessIter>;
+          using key_type = std::decay_t<decltype(key(*first))>;
+          using utility::iter_move;
+
+          difference_type size = last - first;
+          std::size_t nb_chunks = (std::max)(
+            std::size_t(1),
+            (std::min)(thread_pool::instance().concurrency(),
+                       static_cast<std::size_t>(size / min_chunk_size))
+          );
+          auto chunk_bound = [&](std::size_t idx) {
+            return first + static_cast<difference_type>(size * idx / nb_chunks);
+          };
+
+          // Find the extremes of every chunk, and whether the
+          // chunk is already sorted
+          struct chunk_info
+          {
+            key_type min, max;
+            bool sorted;
+          };
+          std::vector<chunk_info> infos(nb_chunks);
+          {
+            task_group group;
+            for (std::size_t idx = 0 ; idx < nb_chunks ; ++idx) {
+              group.run([&, idx] {
+                auto it = chunk_bound(idx);
+                auto chunk_last = chunk_bound(idx + 1);
+                key_type prev = key(*it);
+                chunk_info info = { prev, prev, true };
+                while (++it != chunk_last) {
+                  key_type current = key(*it);
+                  info.sorted &= not (current < prev);
+                  info.min = (std::min)(info.min, current);
+                  info.max = (std::max)(info.max, current);
+                  prev = current;
+                }
+                infos[idx] = info;
+              });
+            }
+            group.wait();
+          }
+
+          key_type min = infos[0].min;
+          key_type max = infos[0].max;
+          bool sorted = infos[0].sorted;
+          for (std::size_t idx = 1 ; idx < nb_chunks ; ++idx) {
+            min = (std::min)(min, infos[idx].min);
+            max = (std::max)(max, infos[idx].max);
+            sorted = sorted && infos[idx].sorted
+                            && not (key(*chunk_bound(idx)) < key(*(chunk_bound(idx) - 1)));
+          }
+          if (sorted) return;
+
+          // Same number of bins as the sequential algorithm
+          unsigned log_divisor = get_log_divisor<int_log_mean_bin_size>(
+              size, rough_log_2_size(key_type(max - min)));
+          key_type div_min = min >> log_divisor;
+          std::size_t bin_count = std::size_t((max >> log_divisor) - div_min) + 1;
+          auto bin_index = [&](auto&& value) {
+            return std::size_t((key(std::forward<decltype(value)>(value)) >> log_divisor) - div_min);
+          };
+
+          // Compute the histogram of every chunk
+          std::vector<std::vector<std::size_t>> counts(nb_chunks);
+          {
+            task_group group;
+            for (std::size_t idx = 0 ; idx < nb_chunks ; ++idx) {
+              group.run([&, idx] {
+                auto& chunk_counts = counts[idx];
+                chunk_counts.assign(bin_count, 0);
+                for (auto it = chunk_bound(idx) ; it != chunk_bound(idx + 1) ; ++it) {
+                  ++chunk_counts[bin_index(*it)];
+                }
+              });
+            }
+            group.wait();
+          }
+
+          // Turn the histograms into the offsets where every chunk
+          // writes its elements
+          std::vector<std::size_t> bin_bounds(bin_count + 1);
+          std::size_t total = 0;
+          for (std::size_t bin = 0 ; bin < bin_count ; ++bin) {
+            bin_bounds[bin] = total;
+            for (auto& chunk_counts: counts) {
+              std::size_t count = chunk_counts[bin];
+              chunk_counts[bin] = total;
+              total += count;
+            }
+          }
+          bin_bounds[bin_count] = total;
+
+          {
+            task_group group;
+            for (std::size_t idx = 0 ; idx < nb_chunks ; ++idx) {
+              group.run([&, idx] {
+                auto& chunk_offsets = counts[idx];
+                for (auto it = chunk_bound(idx) ; it != chunk_bound(idx + 1) ; ++it) {
+                  ::new(buffer + chunk_offsets[bin_index(*it)]++) rvalue_type(iter_move(it));
+                }
+              });
+            }
+            group.wait();
+          }
+          {
+            task_group group;
+            for (std::size_t idx = 0 ; idx < nb_chunks ; ++idx) {
+              group.run([&, idx] {
+                auto buffer_first = buffer + (chunk_bound(idx) - first);
+                auto buffer_last = buffer + (chunk_bound(idx + 1) - first);
+                cppsort::detail::move(buffer_first, buffer_last, chunk_bound(idx));
+                cppsort::detail::destroy(buffer_first, buffer_last);
+              });
+            }
+            group.wait();
+          }
+
+          // Every bin holds a single key when no bit was shifted out
+          if (log_divisor == 0) return;
+
+          // Sort every bin in its own task
+          task_group group;
+          for (std::size_t bin = 0 ; bin < bin_count ; ++bin) {
+            std::size_t start_offset = bin_bounds[bin];
+            std::size_t end_offset = bin_bounds[bin + 1];
+            if (end_offset - start_offset < 2) continue;
+
+            group.run([=] {
+              auto bin_first = first + static_cast<difference_type>(start_offset);
+              auto bin_last = first + static_cast<difference_type>(end_offset);
+              if (end_offset - start_offset >= min_parallel_size) {
+                sort(bin_first, bin_last, buffer + start_offset, key, sequential_sort);
+              } else {
+                sequential_sort(bin_first, bin_last);
+              }
+            });
+          }
+          group.wait();
+        }
+
+        template<typename RandomAccessIter, typename KeyFunction, typename SequentialSort>
+        auto parallel_spread_sort_start(RandomAccessIter first, RandomAccessIter last,
+                                        KeyFunction key, SequentialSort sequential_sort,
+                                        std::true_type)
+            -> void
+        {
+          using rvalue_type = rvalue_type_t<RandomAccessIter>;
+
+          auto size = last - first;
+          if (size < min_parallel_size || thread_pool::instance().concurrency() == 1) {
+            sequential_sort(std::move(first), std::move(last));
+            return;
+          }
+
+          // Allocate the scatter buffer upfront, fall back to the
+          // sequential algorithm - which sorts in-place - if we can't
+          std::unique_ptr<rvalue_type, operator_deleter> buffer(
+            static_cast<rvalue_type*>(::operator new(size * sizeof(rvalue_type), std::nothrow)),
+            operator_deleter(size * sizeof(rvalue_type))
+          );
+          if (buffer == nullptr) {
+            sequential_sort(std::move(first), std::move(last));
+            return;
+          }
+
+          sort(std::move(first), std::move(last), buffer.get(),
+               std::move(key), std::move(sequential_sort));
+        }
+
+        template<typename RandomAccessIter, typename KeyFunction, typename SequentialSort>
+        auto parallel_spread_sort_start(RandomAccessIter first, RandomAccessIter last,
+                                        KeyFunction, SequentialSort sequential_sort,
+                                        std::false_type)
+            -> void
+        {
+          sequential_sort(std::move(first), std::move(last));
+        }
+
+        // The parallel passes require moves not to throw since
+        // elements are scattered out of the collection
+        template<typename RandomAccessIter>
+        using can_run_parallel = std::integral_constant<bool,
+          std::is_nothrow_move_constructible<rvalue_type_t<RandomAccessIter>>::value &&
+          std::is_nothrow_move_assignable<rvalue_type_t<RandomAccessIter>>::value
+        >;
+    }
+
+    template<typename RandomAccessIter, typename Projection>
+    auto parallel_integer_sort(RandomAccessIter first, RandomAccessIter last,
+                               Projection projection)
+        -> void
+    {
+      using namespace parallel_spread_sort_detail;
+      auto sequential_sort = [projection](RandomAccessIter first, RandomAccessIter last) {
+        auto&& proj = utility::as_function(projection);
+        if (last - first < min_sort_size)
+          pdqsort(first, last, std::less<>{}, projection);
+        else
+          integer_sort(first, last, proj(*first) >> 0, projection);
+      };
+      parallel_spread_sort_start(std::move(first), std::move(last),
+                                 integer_key<Projection>{projection},
+                                 std::move(sequential_sort),
+                                 can_run_parallel<RandomAccessIter>{});
+    }
+
+    template<typename RandomAccessIter, typename Projection>
+    auto parallel_float_sort(RandomAccessIter first, RandomAccessIter last,
+                             Projection projection)
+        -> void
+    {
+      using namespace parallel_spread_sort_detail;
+      auto sequential_sort = [projection](RandomAccessIter first, RandomAccessIter last) {
+        if (last - first < min_sort_size)
+          pdqsort(first, last, std::less<>{}, projection);
+        else
+          float_sort(first, last, projection);
+      };
+      parallel_spread_sort_start(std::move(first), std::move(last),
+                                 float_key<Projection>{projection},
+                                 std::move(sequential_sort),
+                                 can_run_parallel<RandomAccessIter>{});
+    }
+  }
+}}}
+
+#endif // CPPSORT_DETAIL_SPREADSORT_DETAIL_PARALLEL_SPREAD_SORT_H_
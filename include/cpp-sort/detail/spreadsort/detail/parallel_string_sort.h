@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_SPREADSORT_DETAIL_PARALLEL_STRING_SORT_H_
+#define CPPSORT_DETAIL_SPREADSORT_DETAIL_PARALLEL_STRING_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/iter_move.h>
+#include "constants.h"
+#include "string_sort.h"
+#include "../../iterator_traits.h"
+#include "../../memory.h"
+#include "../../move.h"
+#include "../../pdqsort.h"
+#include "../../thread_pool.h"
+#include "../../type_traits.h"
+
+namespace cppsort
+{
+namespace detail
+{
+namespace spreadsort
+{
+  namespace detail {
+    ////////////////////////////////////////////////////////////
+    // Parallel string_sort
+    //
+    // The collection is cut into one chunk per thread, and the
+    // characters shared by all the strings are skipped with a
+    // concurrent scan of the chunks. Every chunk then computes
+    // the histogram of the next character, and scatters its
+    // elements to a buffer at offsets computed from the prefix
+    // sums of all histograms, before the bins are moved back to
+    // the collection. Every bin is then sorted in its own task,
+    // either with another parallel pass if it is still big enough,
+    // or with the sequential algorithm.
+
+    namespace parallel_string_sort_detail
+    {
+        enum {
+            // Below this size, bins are sorted sequentially
+            min_parallel_size = 1 << 16,
+
+            // Minimum number of elements handled by a single task
+            // during a parallel pass
+            min_chunk_size = 1 << 14
+        };
+
+        // Index of the bin of a string: empties come first when
+        // sorting in ascending order, and last otherwise
+        template<bool Reverse, typename Unsigned_char_type, typename String>
+        auto bin_index(const String& str, std::size_t char_offset)
+            -> std::size_t
+        {
+          constexpr std::size_t bin_count = 1 << (sizeof(Unsigned_char_type) * 8);
+          if (str.size() <= char_offset) {
+            return Reverse ? bin_count : 0;
+          }
+          auto c = static_cast<Unsigned_char_type>(str[char_offset]);
+          return Reverse ? bin_count - 1 - c : c + 1;
+        }
+
+        template<bool Reverse, typename Unsigned_char_type,
+                 typename RandomAccessIter, typename Projection>
+        auto sequential_sort(RandomAccessIter first, RandomAccessIter last,
+                             std::size_t char_offset, Projection projection)
+            -> void
+        {
+          std::size_t bin_sizes[(1 << (8 * sizeof(Unsigned_char_type))) + 1];
+          std::vector<RandomAccessIter> bin_cache;
+          if (Reverse) {
+            reverse_string_sort_rec<Unsigned_char_type>(first, last, char_offset,
+                                                        bin_cache, 0, bin_sizes,
+                                                        std::move(projection));
+          } else {
+            string_sort_rec<Unsigned_char_type>(first, last, char_offset,
+                                                bin_cache, 0, bin_sizes,
+                                                std::move(projection));
+          }
+        }
+
+        template<bool Reverse, typename Unsigned_char_type,
+                 typename RandomAccessIter, typename Projection>
+        auto small_sort(RandomAccessIter first, RandomAccessIter last,
+                        std::size_t char_offset, Projection projection)
+            -> void
+        {
+          if (Reverse) {
+            pdqsort(std::move(first), std::move(last),
+                    offset_greater_than<Projection, Unsigned_char_type>(char_offset, projection),
+                    utility::identity{});
+          } else {
+            pdqsort(std::move(first), std::move(last),
+                    offset_less_than<Projection, Unsigned_char_type>(char_offset, projection),
+                    utility::identity{});
+          }
+        }
+
+        // Position of the first character from char_offset where str
+        // differs from ref, bounded to leave at least one character
+        // in str
+        template<typename Unsigned_char_type, typename String>
+        auto common_prefix(const String& str, const String& ref,
+                           std::size_t char_offset, std::size_t limit)
+            -> std::size_t
+        {
+          limit = (std::min)(limit, str.size() - 1);
+          while (char_offset < limit &&
+                 static_cast<Unsigned_char_type>(str[char_offset]) ==
+                 static_cast<Unsigned_char_type>(ref[char_offset])) {
+            ++char_offset;
+          }
+          return char_offset;
+        }
+
+        template<bool Reverse, typename Unsigned_char_type,
+                 typename RandomAccessIter, typename Projection>
+        auto sort(RandomAccessIter first, RandomAccessIter last,
+                  std::size_t char_offset,
+                  rvalue_type_t<RandomAccessIter>* buffer,
+                  Projection projection)
+            -> void
+        {
+          using difference_type = difference_type_t<RandomAccessIter>;
+          using rvalue_type = rvalue_type_t<RandomAccessIter>;
+          using utility::iter_move;
+          auto&& proj = utility::as_function(projection);
+
+          constexpr std::size_t bin_count = 1 << (sizeof(Unsigned_char_type) * 8);
+          constexpr std::size_t membin_count = bin_count + 1;
+
+          difference_type size = last - first;
+          std::size_t nb_chunks = (std::max)(
+            std::size_t(1),
+            (std::min)(thread_pool::instance().concurrency(),
+                       static_cast<std::size_t>(size / min_chunk_size))
+          );
+          auto chunk_bound = [&](std::size_t idx) {
+            return first + static_cast<difference_type>(size * idx / nb_chunks);
+          };
+
+          // Find a non-empty reference string, if all are empty
+          // then they are equivalent
+          auto ref = std::find_if(first, last, [&](const auto& value) {
+            return proj(value).size() > char_offset;
+          });
+          if (ref == last) return;
+
+          // Skip the characters shared by all the non-empty strings,
+          // every chunk finds its own common prefix with the reference
+          {
+            std::vector<std::size_t> offsets(nb_chunks);
+            task_group group;
+            for (std::size_t idx = 0 ; idx < nb_chunks ; ++idx) {
+              group.run([&, idx] {
+                auto&& ref_str = proj(*ref);
+                std::size_t limit = ref_str.size() - 1;
+                for (auto it = chunk_bound(idx) ; it != chunk_bound(idx + 1) ; ++it) {
+                  auto&& str = proj(*it);
+                  if (str.size() > char_offset) {
+                    limit = common_prefix<Unsigned_char_type>(str, ref_str, char_offset, limit);
+                    if (limit == char_offset) break;
+                  }
+                }
+                offsets[idx] = limit;
+              });
+            }
+            group.wait();
+            char_offset = *std::min_element(offsets.begin(), offsets.end());
+          }
+
+          // Compute the histogram of every chunk
+          std::vector<std::vector<std::size_t>> counts(nb_chunks);
+          {
+            task_group group;
+            for (std::size_t idx = 0 ; idx < nb_chunks ; ++idx) {
+              group.run([&, idx] {
+                auto& chunk_counts = counts[idx];
+                chunk_counts.assign(membin_count, 0);
+                for (auto it = chunk_bound(idx) ; it != chunk_bound(idx + 1) ; ++it) {
+                  ++chunk_counts[bin_index<Reverse, Unsigned_char_type>(proj(*it), char_offset)];
+                }
+              });
+            }
+            group.wait();
+          }
+
+          // Turn the histograms into the offsets where every chunk
+          // writes its elements
+          std::vector<std::size_t> bin_bounds(membin_count + 1);
+          std::size_t total = 0;
+          std::size_t nb_bins = 0;
+          for (std::size_t bin = 0 ; bin < membin_count ; ++bin) {
+            bin_bounds[bin] = total;
+            std::size_t bin_size = 0;
+            for (auto& chunk_counts: counts) {
+              std::size_t count = chunk_counts[bin];
+              chunk_counts[bin] = total + bin_size;
+              bin_size += count;
+            }
+            total += bin_size;
+            nb_bins += (bin_size != 0);
+          }
+          bin_bounds[membin_count] = total;
+
+          // When every element falls in the same bin, there is
+          // nothing to move and we can directly handle the bin
+          if (nb_bins > 1) {
+            {
+              task_group group;
+              for (std::size_t idx = 0 ; idx < nb_chunks ; ++idx) {
+                group.run([&, idx] {
+                  auto& chunk_offsets = counts[idx];
+                  for (auto it = chunk_bound(idx) ; it != chunk_bound(idx + 1) ; ++it) {
+                    auto bin = bin_index<Reverse, Unsigned_char_type>(proj(*it), char_offset);
+                    ::new(buffer + chunk_offsets[bin]++) rvalue_type(iter_move(it));
+                  }
+                });
+              }
+              group.wait();
+            }
+            {
+              task_group group;
+              for (std::size_t idx = 0 ; idx < nb_chunks ; ++idx) {
+                group.run([&, idx] {
+                  auto buffer_first = buffer + (chunk_bound(idx) - first);
+                  auto buffer_last = buffer + (chunk_bound(idx + 1) - first);
+                  cppsort::detail::move(buffer_first, buffer_last, chunk_bound(idx));
+                  cppsort::detail::destroy(buffer_first, buffer_last);
+                });
+              }
+              group.wait();
+            }
+          }
+
+          // Sort every bin in its own task, the empties are
+          // equivalent and don't need to be sorted
+          std::size_t empties_bin = Reverse ? bin_count : 0;
+          task_group group;
+          for (std::size_t bin = 0 ; bin < membin_count ; ++bin) {
+            std::size_t start_offset = bin_bounds[bin];
+            std::size_t end_offset = bin_bounds[bin + 1];
+            if (bin == empties_bin || end_offset - start_offset < 2) continue;
+
+            group.run([=] {
+              auto bin_first = first + static_cast<difference_type>(start_offset);
+              auto bin_last = first + static_cast<difference_type>(end_offset);
+              auto bin_size = end_offset - start_offset;
+              if (bin_size < bin_count) {
+                // Same threshold as the sequential algorithm
+                small_sort<Reverse, Unsigned_char_type>(bin_first, bin_last,
+                                                        char_offset + 1, projection);
+              } else if (bin_size >= min_parallel_size) {
+                sort<Reverse, Unsigned_char_type>(bin_first, bin_last, char_offset + 1,
+                                                  buffer + start_offset, projection);
+              } else {
+                sequential_sort<Reverse, Unsigned_char_type>(bin_first, bin_last,
+                                                             char_offset + 1, projection);
+              }
+            });
+          }
+          group.wait();
+        }
+
+        template<bool Reverse, typename Unsigned_char_type,
+                 typename RandomAccessIter, typename Projection>
+        auto parallel_string_sort_start(RandomAccessIter first, RandomAccessIter last,
+                                        Projection projection, std::true_type)
+            -> void
+        {
+          using rvalue_type = rvalue_type_t<RandomAccessIter>;
+
+          auto size = last - first;
+          if (size < min_parallel_size || thread_pool::instance().concurrency() == 1) {
+            sequential_sort<Reverse, Unsigned_char_type>(std::move(first), std::move(last),
+                                                         0, std::move(projection));
+            return;
+          }
+
+          // Allocate the scatter buffer upfront, fall back to the
+          // sequential algorithm - which sorts in-place - if we can't
+          std::unique_ptr<rvalue_type, operator_deleter> buffer(
+            static_cast<rvalue_type*>(::operator new(size * sizeof(rvalue_type), std::nothrow)),
+            operator_deleter(size * sizeof(rvalue_type))
+          );
+          if (buffer == nullptr) {
+            sequential_sort<Reverse, Unsigned_char_type>(std::move(first), std::move(last),
+                                                         0, std::move(projection));
+            return;
+          }
+
+          sort<Reverse, Unsigned_char_type>(std::move(first), std::move(last), 0,
+                                            buffer.get(), std::move(projection));
+        }
+
+        template<bool Reverse, typename Unsigned_char_type,
+                 typename RandomAccessIter, typename Projection>
+        auto parallel_string_sort_start(RandomAccessIter first, RandomAccessIter last,
+                                        Projection projection, std::false_type)
+            -> void
+        {
+          sequential_sort<Reverse, Unsigned_char_type>(std::move(first), std::move(last),
+                                                       0, std::move(projection));
+        }
+    }
+
+    template<bool Reverse, typename RandomAccessIter, typename Projection,
+             typename Unsigned_char_type>
+    auto parallel_string_sort(RandomAccessIter first, RandomAccessIter last,
+                              Projection projection, Unsigned_char_type)
+        -> cppsort::detail::enable_if_t<sizeof(Unsigned_char_type) <= 2, void>
+    {
+      // The parallel passes require moves not to throw since
+      // elements are scattered out of the collection
+      using rvalue_type = rvalue_type_t<RandomAccessIter>;
+      using can_run_parallel = std::integral_constant<bool,
+        std::is_nothrow_move_constructible<rvalue_type>::value &&
+        std::is_nothrow_move_assignable<rvalue_type>::value
+      >;
+
+      parallel_string_sort_detail::parallel_string_sort_start<Reverse, Unsigned_char_type>(
+        std::move(first), std::move(last), std::move(projection),
+        can_run_parallel{}
+      );
+    }
+  }
+}}}
+
+#endif // CPPSORT_DETAIL_SPREADSORT_DETAIL_PARALLEL_STRING_SORT_H_
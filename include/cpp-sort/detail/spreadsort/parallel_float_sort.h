@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_SPREADSORT_PARALLEL_FLOAT_SORT_H_
+#define CPPSORT_DETAIL_SPREADSORT_PARALLEL_FLOAT_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <functional>
+#include <utility>
+#include "detail/constants.h"
+#include "detail/parallel_spread_sort.h"
+#include "../pdqsort.h"
+
+namespace cppsort
+{
+namespace detail
+{
+namespace spreadsort
+{
+  // Parallel version of float_sort: the bins of the most
+  // significant bits are computed and filled concurrently, then
+  // every bin is sorted in its own task
+
+  template<typename RandomAccessIter, typename Projection>
+  auto parallel_float_sort(RandomAccessIter first, RandomAccessIter last,
+                           Projection projection)
+      -> void
+  {
+    // Don't sort if it's too small to optimize.
+    if (last - first < detail::min_sort_size)
+      pdqsort(std::move(first), std::move(last),
+              std::less<>{}, std::move(projection));
+    else
+      detail::parallel_float_sort(std::move(first), std::move(last),
+                                  std::move(projection));
+  }
+}}}
+
+#endif // CPPSORT_DETAIL_SPREADSORT_PARALLEL_FLOAT_SORT_H_
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_SPREADSORT_PARALLEL_STRING_SORT_H_
+#define CPPSORT_DETAIL_SPREADSORT_PARALLEL_STRING_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <functional>
+#include <utility>
+#include "detail/constants.h"
+#include "detail/parallel_string_sort.h"
+#include "../pdqsort.h"
+
+namespace cppsort
+{
+namespace detail
+{
+namespace spreadsort
+{
+  // Parallel versions of string_sort and reverse_string_sort: the
+  // character bins are computed and filled concurrently, then every
+  // bin is sorted in its own task
+
+  template<typename RandomAccessIter, typename Projection, typename Unsigned_char_type>
+  auto parallel_string_sort(RandomAccessIter first, RandomAccessIter last,
+                            Projection projection, Unsigned_char_type unused)
+      -> void
+  {
+    //Don't sort if it's too small to optimize
+    if (last - first < detail::min_sort_size)
+      pdqsort(std::move(first), std::move(last),
+              std::less<>{}, std::move(projection));
+    else
+      detail::parallel_string_sort<false>(std::move(first), std::move(last),
+                                          std::move(projection), unused);
+  }
+
+  template<typename RandomAccessIter, typename Compare,
+           typename Projection, typename Unsigned_char_type>
+  auto parallel_reverse_string_sort(RandomAccessIter first, RandomAccessIter last,
+                                    Compare comp, Projection projection,
+                                    Unsigned_char_type unused)
+      -> void
+  {
+    //Don't sort if it's too small to optimize.
+    if (last - first < detail::min_sort_size)
+      pdqsort(std::move(first), std::move(last),
+              std::move(comp), std::move(projection));
+    else
+      detail::parallel_string_sort<true>(std::move(first), std::move(last),
+                                         std::move(projection), unused);
+  }
+}}}
+
+#endif // CPPSORT_DETAIL_SPREADSORT_PARALLEL_STRING_SORT_H_
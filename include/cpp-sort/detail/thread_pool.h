@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_THREAD_POOL_H_
+#define CPPSORT_DETAIL_THREAD_POOL_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "config.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Thread pool
+    //
+    // Lazily-created process-wide pool of worker threads used
+    // by the parallel sorters. Every worker owns a deque of
+    // tasks: it pushes and pops tasks from the back of its own
+    // deque, and steals tasks from the front of the deques of
+    // the other workers when it runs out of work. Threads that
+    // are not part of the pool push their tasks to a shared
+    // queue instead.
+    //
+    // The number of threads taking part in the computations is
+    // std::thread::hardware_concurrency() by default, and can be
+    // changed by defining CPPSORT_THREAD_POOL_SIZE. The calling
+    // thread always takes part in the computations while it is
+    // waiting for a task_group, so the pool only spawns one
+    // fewer worker than that.
+
+    class thread_pool
+    {
+        public:
+
+            using task_type = std::function<void()>;
+
+            thread_pool(const thread_pool&) = delete;
+            thread_pool& operator=(const thread_pool&) = delete;
+
+            ////////////////////////////////////////////////////////////
+            // Global instance
+
+            static auto instance()
+                -> thread_pool&
+            {
+                static thread_pool pool(default_concurrency());
+                return pool;
+            }
+
+            static auto default_concurrency()
+                -> std::size_t
+            {
+#ifdef CPPSORT_THREAD_POOL_SIZE
+                std::size_t res = CPPSORT_THREAD_POOL_SIZE;
+#else
+                std::size_t res = std::thread::hardware_concurrency();
+#endif
+                return res > 0 ? res : 1;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Construction & destruction
+
+            explicit thread_pool(std::size_t concurrency):
+                queues_(new task_queue[concurrency]),
+                queues_size_(concurrency),
+                pending_(0),
+                stop_(false)
+            {
+                workers_.reserve(concurrency - 1);
+                try {
+                    // The last queue is shared by the threads that are
+                    // not part of the pool
+                    for (std::size_t idx = 0 ; idx < concurrency - 1 ; ++idx) {
+                        workers_.emplace_back([this, idx] { work(idx); });
+                    }
+                } catch (...) {
+                    // Run with the workers that could be created, the
+                    // ones already started might be reading the size
+                    queues_size_.store(workers_.size() + 1, std::memory_order_release);
+                }
+            }
+
+            ~thread_pool()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(sleep_mutex_);
+                    stop_ = true;
+                }
+                sleep_cv_.notify_all();
+                for (auto& worker: workers_) {
+                    worker.join();
+                }
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Observers
+
+            // Number of threads that can execute tasks concurrently,
+            // including the thread waiting for the results
+            auto concurrency() const noexcept
+                -> std::size_t
+            {
+                return workers_.size() + 1;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Tasks scheduling
+
+            auto push(task_type task)
+                -> void
+            {
+                auto& queue = queues_[current_queue_index()];
+                pending_.fetch_add(1, std::memory_order_relaxed);
+                try {
+                    std::lock_guard<std::mutex> lock(queue.mutex);
+                    queue.tasks.push_back(std::move(task));
+                } catch (...) {
+                    pending_.fetch_sub(1, std::memory_order_relaxed);
+                    throw;
+                }
+                if (not workers_.empty()) {
+                    // Make sure that a sleeping worker can't miss the
+                    // new task between its check and its wait
+                    { std::lock_guard<std::mutex> lock(sleep_mutex_); }
+                    sleep_cv_.notify_one();
+                }
+            }
+
+            // Execute a single pending task if there is one, favouring
+            // the most recent task of the current thread's queue,
+            // returns whether a task was run
+            auto run_pending_task()
+                -> bool
+            {
+                task_type task;
+                if (not pop_task(task)) {
+                    return false;
+                }
+                task();
+                return true;
+            }
+
+        private:
+
+            struct task_queue
+            {
+                std::mutex mutex;
+                std::deque<task_type> tasks;
+            };
+
+            auto current_queue_index() const noexcept
+                -> std::size_t
+            {
+                auto idx = worker_index();
+                auto size = queues_size_.load(std::memory_order_acquire);
+                return idx < size ? idx : size - 1;
+            }
+
+            static auto worker_index() noexcept
+                -> std::size_t&
+            {
+                // Threads that don't belong to a pool get an index that
+                // is out of bounds for every pool
+                static thread_local std::size_t index = static_cast<std::size_t>(-1);
+                return index;
+            }
+
+            auto pop_task(task_type& task)
+                -> bool
+            {
+                if (pending_.load(std::memory_order_acquire) == 0) {
+                    return false;
+                }
+
+                // Most recent task from our own queue first
+                auto own = current_queue_index();
+                {
+                    auto& queue = queues_[own];
+                    std::lock_guard<std::mutex> lock(queue.mutex);
+                    if (not queue.tasks.empty()) {
+                        task = std::move(queue.tasks.back());
+                        queue.tasks.pop_back();
+                        pending_.fetch_sub(1, std::memory_order_relaxed);
+                        return true;
+                    }
+                }
+
+                // Steal the oldest task of another queue: those are
+                // generally the biggest ones in divide-and-conquer
+                // algorithms
+                auto size = queues_size_.load(std::memory_order_acquire);
+                for (std::size_t offset = 1 ; offset < size ; ++offset) {
+                    auto& queue = queues_[(own + offset) % size];
+                    std::lock_guard<std::mutex> lock(queue.mutex);
+                    if (not queue.tasks.empty()) {
+                        task = std::move(queue.tasks.front());
+                        queue.tasks.pop_front();
+                        pending_.fetch_sub(1, std::memory_order_relaxed);
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            auto work(std::size_t idx)
+                -> void
+            {
+                worker_index() = idx;
+                while (true) {
+                    if (run_pending_task()) {
+                        continue;
+                    }
+
+                    std::unique_lock<std::mutex> lock(sleep_mutex_);
+                    sleep_cv_.wait(lock, [this] {
+                        return stop_ || pending_.load(std::memory_order_acquire) > 0;
+                    });
+                    if (stop_) {
+                        return;
+                    }
+                }
+            }
+
+            std::unique_ptr<task_queue[]> queues_;
+            std::atomic<std::size_t> queues_size_;
+            std::vector<std::thread> workers_;
+            std::atomic<std::size_t> pending_;
+
+            std::mutex sleep_mutex_;
+            std::condition_variable sleep_cv_;
+            bool stop_;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Task group
+    //
+    // Set of tasks pushed to the thread pool that can be waited
+    // for together; tasks run from a group can themselves run
+    // new tasks in the same group. The waiting thread executes
+    // pending tasks until every task of the group has completed,
+    // then rethrows the first exception thrown by a task if any.
+
+    class task_group
+    {
+        public:
+
+            task_group(const task_group&) = delete;
+            task_group& operator=(const task_group&) = delete;
+
+            task_group():
+                pool_(thread_pool::instance()),
+                pending_(0)
+            {}
+
+            ~task_group()
+            {
+                // Tasks reference the group, they can't outlive it
+                while (pending_.load(std::memory_order_acquire) > 0) {
+                    if (not pool_.run_pending_task()) {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+
+            auto concurrency() const noexcept
+                -> std::size_t
+            {
+                return pool_.concurrency();
+            }
+
+            template<typename Function>
+            auto run(Function&& function)
+                -> void
+            {
+                if (pool_.concurrency() == 1) {
+                    // No need to defer the task if nobody can steal it
+                    run_now(function);
+                    return;
+                }
+
+                pending_.fetch_add(1, std::memory_order_relaxed);
+                try {
+                    pool_.push([this, function=std::forward<Function>(function)]() mutable {
+                        run_now(function);
+                        pending_.fetch_sub(1, std::memory_order_release);
+                    });
+                } catch (...) {
+                    pending_.fetch_sub(1, std::memory_order_relaxed);
+                    throw;
+                }
+            }
+
+            auto wait()
+                -> void
+            {
+                while (pending_.load(std::memory_order_acquire) > 0) {
+                    if (not pool_.run_pending_task()) {
+                        std::this_thread::yield();
+                    }
+                }
+
+                if (exception_) {
+                    std::rethrow_exception(std::exchange(exception_, nullptr));
+                }
+            }
+
+        private:
+
+            template<typename Function>
+            auto run_now(Function& function) noexcept
+                -> void
+            {
+                try {
+                    function();
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(exception_mutex_);
+                    if (not exception_) {
+                        exception_ = std::current_exception();
+                    }
+                }
+            }
+
+            thread_pool& pool_;
+            std::atomic<std::size_t> pending_;
+            std::mutex exception_mutex_;
+            std::exception_ptr exception_;
+    };
+}}
+
+#endif // CPPSORT_DETAIL_THREAD_POOL_H_
@@ -47,6 +47,7 @@
 #include "iterator_traits.h"
 #include "lower_bound.h"
 #include "memory.h"
+#include "merge_kernel.h"
 #include "move.h"
 #include "reverse.h"
 #include "rotate.h"
@@ -454,6 +455,15 @@ namespace detail
             std::unique_ptr<rvalue_type, destruct_n<rvalue_type>&> h2(buffer.get(), d);
             uninitialized_move(base1, base1 + len1, buffer.get(), d);
 
+            using use_kernel = use_merge_kernel<rvalue_type*, iterator, iterator,
+                                                Compare, Projection, Projection>;
+            if (use_kernel::value) {
+                merge_kernel_forward(buffer.get(), buffer.get() + len1,
+                                     base2, base2 + len2, base1,
+                                     std::move(compare), projection, projection, use_kernel{});
+                return;
+            }
+
             auto cursor1 = buffer.get();
             auto cursor2 = base2;
             auto dest = base1;
@@ -598,6 +608,15 @@ namespace detail
             std::unique_ptr<rvalue_type, destruct_n<rvalue_type>&> h2(buffer.get(), d);
             uninitialized_move(base2, base2 + len2, buffer.get(), d);
 
+            using use_kernel = use_merge_kernel<iterator, rvalue_type*, iterator,
+                                                Compare, Projection, Projection>;
+            if (use_kernel::value) {
+                merge_kernel_backward(base1, base1 + len1, buffer.get(), buffer.get() + len2,
+                                      base2 + len2, std::move(compare), projection, projection,
+                                      use_kernel{});
+                return;
+            }
+
             auto cursor1 = base1 + len1;
             auto cursor2 = buffer.get() + (len2 - 1);
             auto dest = base2 + (len2 - 1);
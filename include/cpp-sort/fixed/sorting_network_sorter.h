@@ -9,12 +9,16 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <cstddef>
+#include <functional>
 #include <iterator>
 #include <type_traits>
 #include <utility>
 #include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/functional.h>
 #include "../detail/empty_sorter.h"
+#include "../detail/sorting_network/simd.h"
+#include "../detail/type_traits.h"
 
 namespace cppsort
 {
@@ -41,11 +45,35 @@ namespace cppsort
         struct sorting_network_sorter_impl<1u>:
             cppsort::detail::empty_network_sorter_impl
         {};
+
+        // Runs the network in vector registers when the elements
+        // and the comparison are simple enough to allow it
+        template<std::size_t N>
+        struct sorting_network_simd_sorter_impl:
+            sorting_network_sorter_impl<N>
+        {
+            template<
+                typename RandomAccessIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = detail::enable_if_t<is_projection_iterator_v<
+                    Projection, RandomAccessIterator, Compare
+                >>
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> void
+            {
+                sort_network_simd<N>(sorting_network_sorter_impl<N>{},
+                                     std::move(first), std::move(last),
+                                     std::move(compare), std::move(projection));
+            }
+        };
     }
 
     template<std::size_t N>
     struct sorting_network_sorter:
-        sorter_facade<detail::sorting_network_sorter_impl<N>>
+        sorter_facade<detail::sorting_network_simd_sorter_impl<N>>
     {};
 
     ////////////////////////////////////////////////////////////
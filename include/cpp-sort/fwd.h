@@ -25,6 +25,7 @@ namespace cppsort
     // Sorters
 
     struct adaptive_shivers_sorter;
+    struct auto_sorter;
     template<typename BufferProvider>
     struct block_sorter;
     struct cartesian_tree_sorter;
@@ -39,9 +40,27 @@ namespace cppsort
     struct heap_sorter;
     struct insertion_sorter;
     struct integer_spread_sorter;
+    template<typename BufferProvider>
+    struct lsd_radix_sorter;
     struct mel_sorter;
     struct merge_insertion_sorter;
     struct merge_sorter;
+    struct multikey_quick_sorter;
+    struct parallel_counting_sorter;
+    struct parallel_float_spread_sorter;
+    template<typename BufferProvider>
+    struct parallel_grail_sorter;
+    struct parallel_integer_spread_sorter;
+    struct parallel_merge_sorter;
+    struct parallel_pdq_sorter;
+    struct parallel_ska_sorter;
+    struct parallel_spin_sorter;
+    struct parallel_spread_sorter;
+    struct parallel_string_spread_sorter;
+    struct parallel_tim_sorter;
+    struct parallel_verge_sorter;
+    template<typename BufferProvider>
+    struct parallel_wiki_sorter;
     struct pdq_sorter;
     struct poplar_sorter;
     struct quick_merge_sorter;
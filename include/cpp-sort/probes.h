@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2021 Morwenn
+ * Copyright (c) 2016-2022 Morwenn
  * SPDX-License-Identifier: MIT
  */
 #ifndef CPPSORT_PROBES_H_
@@ -8,6 +8,10 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <cpp-sort/probes/approx/inv.h>
+#include <cpp-sort/probes/approx/mono.h>
+#include <cpp-sort/probes/approx/rem.h>
+#include <cpp-sort/probes/approx/runs.h>
 #include <cpp-sort/probes/block.h>
 #include <cpp-sort/probes/dis.h>
 #include <cpp-sort/probes/enc.h>
@@ -15,7 +19,9 @@
 #include <cpp-sort/probes/ham.h>
 #include <cpp-sort/probes/inv.h>
 #include <cpp-sort/probes/max.h>
+#include <cpp-sort/probes/monitor.h>
 #include <cpp-sort/probes/mono.h>
+#include <cpp-sort/probes/multi.h>
 #include <cpp-sort/probes/osc.h>
 #include <cpp-sort/probes/par.h>
 #include <cpp-sort/probes/rem.h>
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_PROBES_APPROX_ESTIMATE_H_
+#define CPPSORT_PROBES_APPROX_ESTIMATE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cmath>
+#include <cstddef>
+#include <random>
+
+namespace cppsort
+{
+namespace probe
+{
+namespace approx
+{
+    ////////////////////////////////////////////////////////////
+    // Result of an approximate measure of presortedness: the
+    // measure is within error of value with a probability of
+    // at least 95%, except for approx::rem which only guarantees
+    // that the measure is at least value - error
+
+    template<typename T>
+    struct estimate
+    {
+        T value;
+        T error;
+    };
+
+    // Number of samples drawn by the approximate probes unless
+    // told otherwise
+    constexpr std::size_t default_sample_budget = 1024;
+
+    namespace detail
+    {
+        ////////////////////////////////////////////////////////////
+        // Hoeffding's inequality: the mean of nb_samples independent
+        // samples of a variable in [0, 1] is farther than the returned
+        // value from the expected mean with a probability of at most
+        // 5%; it is multiplied by scale to give the error of the
+        // estimate of a measure
+
+        template<typename T>
+        auto sampling_error(std::size_t nb_samples, T scale)
+            -> T
+        {
+            // sqrt(ln(2 / 0.05) / 2)
+            constexpr double factor = 1.3581015157;
+            double error = std::ceil(factor * static_cast<double>(scale)
+                                     / std::sqrt(static_cast<double>(nb_samples)));
+            return error < static_cast<double>(scale) ? static_cast<T>(error) : scale;
+        }
+
+        template<typename T>
+        auto scale_frequency(std::size_t count, std::size_t nb_samples, T scale)
+            -> T
+        {
+            return static_cast<T>(std::llround(static_cast<double>(count)
+                                               / static_cast<double>(nb_samples)
+                                               * static_cast<double>(scale)));
+        }
+
+        // Thread-local engine only seeded once per thread
+        inline auto random_engine()
+            -> std::mt19937_64&
+        {
+            static thread_local std::mt19937_64 engine(std::random_device{}());
+            return engine;
+        }
+
+        // Uniform random integer in [0, bound), the distribution
+        // isn't required to handle small integer types
+        template<typename Integer>
+        auto random_index(Integer bound)
+            -> Integer
+        {
+            std::uniform_int_distribution<unsigned long long> dist(
+                0, static_cast<unsigned long long>(bound) - 1
+            );
+            return static_cast<Integer>(dist(random_engine()));
+        }
+    }
+}}}
+
+#endif // CPPSORT_PROBES_APPROX_ESTIMATE_H_
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_PROBES_APPROX_INV_H_
+#define CPPSORT_PROBES_APPROX_INV_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/probes/approx/estimate.h>
+#include <cpp-sort/probes/inv.h>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/static_const.h>
+#include "../../detail/iterator_traits.h"
+#include "../../detail/type_traits.h"
+
+namespace cppsort
+{
+namespace probe
+{
+namespace approx
+{
+    namespace detail
+    {
+        struct inv_impl
+        {
+            std::size_t sample_budget;
+
+            constexpr explicit inv_impl(std::size_t sample_budget=default_sample_budget) noexcept:
+                sample_budget(sample_budget != 0 ? sample_budget : 1)
+            {}
+
+            template<
+                typename RandomAccessIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = cppsort::detail::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator, Compare>
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> estimate<cppsort::detail::difference_type_t<RandomAccessIterator>>
+            {
+                static_assert(
+                    std::is_base_of<
+                        std::random_access_iterator_tag,
+                        cppsort::detail::iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "probe::approx::inv requires at least random-access iterators"
+                );
+                using difference_type = cppsort::detail::difference_type_t<RandomAccessIterator>;
+
+                auto&& comp = utility::as_function(compare);
+                auto&& proj = utility::as_function(projection);
+
+                // Compute the measure exactly when it's cheaper
+                auto size = last - first;
+                auto nb_pairs = max_for_size(size);
+                if (static_cast<std::size_t>(nb_pairs) <= sample_budget) {
+                    return { probe::inv(first, last, std::move(compare), std::move(projection)), 0 };
+                }
+
+                // Proportion of inversions among random pairs
+                std::size_t count = 0;
+                for (std::size_t idx = 0 ; idx < sample_budget ; ++idx) {
+                    auto pos1 = random_index(size);
+                    auto pos2 = random_index(static_cast<difference_type>(size - 1));
+                    if (pos2 >= pos1) {
+                        ++pos2;
+                    } else {
+                        std::swap(pos1, pos2);
+                    }
+                    count += comp(proj(first[pos2]), proj(first[pos1]));
+                }
+
+                return {
+                    scale_frequency(count, sample_budget, nb_pairs),
+                    sampling_error(sample_budget, nb_pairs)
+                };
+            }
+
+            template<typename Integer>
+            static constexpr auto max_for_size(Integer n)
+                -> Integer
+            {
+                return n == 0 ? 0 : n * (n - 1) / 2;
+            }
+        };
+    }
+
+    struct inv_t:
+        sorter_facade<detail::inv_impl>
+    {
+        inv_t() = default;
+
+        constexpr explicit inv_t(std::size_t sample_budget) noexcept:
+            sorter_facade<detail::inv_impl>(sample_budget)
+        {}
+    };
+
+    namespace
+    {
+        constexpr auto&& inv = utility::static_const<inv_t>::value;
+    }
+}}}
+
+#endif // CPPSORT_PROBES_APPROX_INV_H_
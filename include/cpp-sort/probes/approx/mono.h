@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_PROBES_APPROX_MONO_H_
+#define CPPSORT_PROBES_APPROX_MONO_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/probes/approx/estimate.h>
+#include <cpp-sort/probes/mono.h>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/static_const.h>
+#include "../../detail/iterator_traits.h"
+#include "../../detail/type_traits.h"
+
+namespace cppsort
+{
+namespace probe
+{
+namespace approx
+{
+    namespace detail
+    {
+        struct mono_impl
+        {
+            std::size_t sample_budget;
+
+            constexpr explicit mono_impl(std::size_t sample_budget=default_sample_budget) noexcept:
+                sample_budget(sample_budget != 0 ? sample_budget : 1)
+            {}
+
+            template<
+                typename RandomAccessIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = cppsort::detail::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator, Compare>
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> estimate<cppsort::detail::difference_type_t<RandomAccessIterator>>
+            {
+                static_assert(
+                    std::is_base_of<
+                        std::random_access_iterator_tag,
+                        cppsort::detail::iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "probe::approx::mono requires at least random-access iterators"
+                );
+                using difference_type = cppsort::detail::difference_type_t<RandomAccessIterator>;
+
+                // Mono isn't a measure of adjacent pairs: the collection is
+                // cut into blocks and the measure is computed on a sample of
+                // whole blocks; with B blocks, the sum of the measures of
+                // the blocks is at most Mono(X) and at least Mono(X) - (B - 1)
+                constexpr difference_type block_size = 64;
+
+                // Compute the measure exactly when it's cheaper
+                auto size = last - first;
+                if (static_cast<std::size_t>(size) <= (std::max)(sample_budget, std::size_t(block_size))) {
+                    return { probe::mono(first, last, std::move(compare), std::move(projection)), 0 };
+                }
+
+                // The last block holds the remaining elements
+                difference_type nb_blocks = size / block_size;
+                auto nb_samples = (std::max)(sample_budget / block_size, std::size_t(1));
+                std::size_t sum = 0;
+                for (std::size_t idx = 0 ; idx < nb_samples ; ++idx) {
+                    auto block = random_index(nb_blocks);
+                    auto block_first = first + static_cast<difference_type>(block * block_size);
+                    auto block_last = block == nb_blocks - 1 ? last : block_first + block_size;
+                    sum += static_cast<std::size_t>(probe::mono(block_first, block_last, compare, projection));
+                }
+
+                // Return the middle of the interval and account for its
+                // width in the error
+                auto lower_bound = scale_frequency(sum, nb_samples, nb_blocks);
+                difference_type half_width = nb_blocks / 2;
+                difference_type value = lower_bound + half_width;
+                difference_type error = sampling_error(nb_samples, size - size % block_size) + half_width;
+                return { (std::min)(value, max_for_size(size)), error };
+            }
+
+            template<typename Integer>
+            static constexpr auto max_for_size(Integer n)
+                -> Integer
+            {
+                return n == 0 ? 0 : (n + 1) / 2 - 1;
+            }
+        };
+    }
+
+    struct mono_t:
+        sorter_facade<detail::mono_impl>
+    {
+        mono_t() = default;
+
+        constexpr explicit mono_t(std::size_t sample_budget) noexcept:
+            sorter_facade<detail::mono_impl>(sample_budget)
+        {}
+    };
+
+    namespace
+    {
+        constexpr auto&& mono = utility::static_const<mono_t>::value;
+    }
+}}}
+
+#endif // CPPSORT_PROBES_APPROX_MONO_H_
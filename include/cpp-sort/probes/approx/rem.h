@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_PROBES_APPROX_REM_H_
+#define CPPSORT_PROBES_APPROX_REM_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cpp-sort/probes/approx/estimate.h>
+#include <cpp-sort/probes/rem.h>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/static_const.h>
+#include "../../detail/iterator_traits.h"
+#include "../../detail/longest_non_descending_subsequence.h"
+#include "../../detail/type_traits.h"
+
+namespace cppsort
+{
+namespace probe
+{
+namespace approx
+{
+    namespace detail
+    {
+        struct rem_impl
+        {
+            std::size_t sample_budget;
+
+            constexpr explicit rem_impl(std::size_t sample_budget=default_sample_budget) noexcept:
+                sample_budget(sample_budget != 0 ? sample_budget : 1)
+            {}
+
+            template<
+                typename RandomAccessIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = cppsort::detail::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator, Compare>
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> estimate<cppsort::detail::difference_type_t<RandomAccessIterator>>
+            {
+                static_assert(
+                    std::is_base_of<
+                        std::random_access_iterator_tag,
+                        cppsort::detail::iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "probe::approx::rem requires at least random-access iterators"
+                );
+                using difference_type = cppsort::detail::difference_type_t<RandomAccessIterator>;
+
+                // Compute the measure exactly when it's cheaper
+                auto size = last - first;
+                if (static_cast<std::size_t>(size) <= sample_budget) {
+                    difference_type rem = probe::rem(first, last, std::move(compare), std::move(projection));
+                    return { rem, 0 };
+                }
+
+                // Longest non-decreasing subsequence of a random
+                // subsequence of the collection: the elements of the
+                // LNDS of the collection that were picked are part of
+                // a non-decreasing subsequence of the sample, so the
+                // proportion of the sample in its LNDS overestimates
+                // the proportion of the collection in its LNDS
+                std::vector<RandomAccessIterator> sample;
+                sample.reserve(sample_budget);
+                for (std::size_t idx = 0 ; idx < sample_budget ; ++idx) {
+                    sample.push_back(first + random_index(size));
+                }
+                std::sort(sample.begin(), sample.end());
+                sample.erase(std::unique(sample.begin(), sample.end()), sample.end());
+
+                auto res = cppsort::detail::longest_non_descending_subsequence<false>(
+                    sample.begin(), sample.end(), sample.size(),
+                    std::move(compare), utility::indirect{} | std::move(projection)
+                );
+                auto nb_samples = static_cast<std::size_t>(res.second);
+                auto lnds_size = static_cast<std::size_t>(res.first);
+
+                difference_type rem = size - scale_frequency(lnds_size, nb_samples, size);
+                return { rem, sampling_error(nb_samples, size) };
+            }
+
+            template<typename Integer>
+            static constexpr auto max_for_size(Integer n)
+                -> Integer
+            {
+                return n == 0 ? 0 : n - 1;
+            }
+        };
+    }
+
+    struct rem_t:
+        sorter_facade<detail::rem_impl>
+    {
+        rem_t() = default;
+
+        constexpr explicit rem_t(std::size_t sample_budget) noexcept:
+            sorter_facade<detail::rem_impl>(sample_budget)
+        {}
+    };
+
+    namespace
+    {
+        constexpr auto&& rem = utility::static_const<rem_t>::value;
+    }
+}}}
+
+#endif // CPPSORT_PROBES_APPROX_REM_H_
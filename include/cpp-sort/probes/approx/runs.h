@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_PROBES_APPROX_RUNS_H_
+#define CPPSORT_PROBES_APPROX_RUNS_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/probes/approx/estimate.h>
+#include <cpp-sort/probes/runs.h>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/static_const.h>
+#include "../../detail/iterator_traits.h"
+#include "../../detail/type_traits.h"
+
+namespace cppsort
+{
+namespace probe
+{
+namespace approx
+{
+    namespace detail
+    {
+        struct runs_impl
+        {
+            std::size_t sample_budget;
+
+            constexpr explicit runs_impl(std::size_t sample_budget=default_sample_budget) noexcept:
+                sample_budget(sample_budget != 0 ? sample_budget : 1)
+            {}
+
+            template<
+                typename RandomAccessIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = cppsort::detail::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator, Compare>
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> estimate<cppsort::detail::difference_type_t<RandomAccessIterator>>
+            {
+                static_assert(
+                    std::is_base_of<
+                        std::random_access_iterator_tag,
+                        cppsort::detail::iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "probe::approx::runs requires at least random-access iterators"
+                );
+                using difference_type = cppsort::detail::difference_type_t<RandomAccessIterator>;
+
+                auto&& comp = utility::as_function(compare);
+                auto&& proj = utility::as_function(projection);
+
+                // Compute the measure exactly when it's cheaper
+                auto size = last - first;
+                difference_type nb_pairs = size == 0 ? 0 : size - 1;
+                if (static_cast<std::size_t>(nb_pairs) <= sample_budget) {
+                    return { probe::runs(first, last, std::move(compare), std::move(projection)), 0 };
+                }
+
+                // Proportion of step-downs among random pairs of
+                // adjacent elements
+                std::size_t count = 0;
+                for (std::size_t idx = 0 ; idx < sample_budget ; ++idx) {
+                    auto pos = random_index(nb_pairs);
+                    count += comp(proj(first[pos + 1]), proj(first[pos]));
+                }
+
+                return {
+                    scale_frequency(count, sample_budget, nb_pairs),
+                    sampling_error(sample_budget, nb_pairs)
+                };
+            }
+
+            template<typename Integer>
+            static constexpr auto max_for_size(Integer n)
+                -> Integer
+            {
+                return n == 0 ? 0 : n - 1;
+            }
+        };
+    }
+
+    struct runs_t:
+        sorter_facade<detail::runs_impl>
+    {
+        runs_t() = default;
+
+        constexpr explicit runs_t(std::size_t sample_budget) noexcept:
+            sorter_facade<detail::runs_impl>(sample_budget)
+        {}
+    };
+
+    namespace
+    {
+        constexpr auto&& runs = utility::static_const<runs_t>::value;
+    }
+}}}
+
+#endif // CPPSORT_PROBES_APPROX_RUNS_H_
@@ -28,16 +28,48 @@ namespace probe
 {
     namespace detail
     {
-        template<typename ForwardIterator, typename Compare, typename Projection>
-        auto block_probe_algo(ForwardIterator first, ForwardIterator last,
-                            cppsort::detail::difference_type_t<ForwardIterator> size,
-                            Compare compare, Projection projection)
+        // iterators holds the iterators of [first, last) sorted
+        // on the values they point to, size must be at least 2
+        template<typename ForwardIterator, typename SortedIterator,
+                 typename Compare, typename Projection>
+        auto block_from_sorted_iterators(ForwardIterator, ForwardIterator last,
+                                         cppsort::detail::difference_type_t<ForwardIterator> size,
+                                         SortedIterator iterators,
+                                         Compare compare, Projection projection)
             -> ::cppsort::detail::difference_type_t<ForwardIterator>
         {
             using difference_type = ::cppsort::detail::difference_type_t<ForwardIterator>;
             auto&& comp = utility::as_function(compare);
             auto&& proj = utility::as_function(projection);
 
+            ////////////////////////////////////////////////////////////
+            // Count the number of consecutive pairs in the original
+            // collection that can't be found in the sorted one
+
+            difference_type count = 0;
+            auto it_last_1 = iterators + (size - 1);
+            for (auto it = iterators; it != it_last_1; ++it) {
+                auto orig_next = std::next(*it);
+                if (orig_next == last) {
+                    if (comp(proj(**it), proj(**it_last_1)) || comp(proj(**it_last_1), proj(**it))) {
+                        ++count;
+                    }
+                    continue;
+                }
+                auto sorted_next = *std::next(it);
+                if (comp(proj(*orig_next), proj(*sorted_next)) || comp(proj(*sorted_next), proj(*orig_next))) {
+                    ++count;
+                }
+            }
+            return count;
+        }
+
+        template<typename ForwardIterator, typename Compare, typename Projection>
+        auto block_probe_algo(ForwardIterator first, ForwardIterator last,
+                            cppsort::detail::difference_type_t<ForwardIterator> size,
+                            Compare compare, Projection projection)
+            -> ::cppsort::detail::difference_type_t<ForwardIterator>
+        {
             if (size < 2) {
                 return 0;
             }
@@ -57,26 +89,8 @@ namespace probe
                 compare, utility::indirect{} | projection
             );
 
-            ////////////////////////////////////////////////////////////
-            // Count the number of consecutive pairs in the original
-            // collection that can't be found in the sorted one
-
-            difference_type count = 0;
-            auto it_last_1 = std::prev(iterators.end());
-            for (auto it = iterators.begin(); it != it_last_1; ++it) {
-                auto orig_next = std::next(*it);
-                if (orig_next == last) {
-                    if (comp(proj(**it), proj(**it_last_1)) || comp(proj(**it_last_1), proj(**it))) {
-                        ++count;
-                    }
-                    continue;
-                }
-                auto sorted_next = *std::next(it);
-                if (comp(proj(*orig_next), proj(*sorted_next)) || comp(proj(*sorted_next), proj(*orig_next))) {
-                    ++count;
-                }
-            }
-            return count;
+            return block_from_sorted_iterators(first, last, size, iterators.begin(),
+                                               std::move(compare), std::move(projection));
         }
 
         struct block_impl
@@ -29,35 +29,20 @@ namespace probe
 {
     namespace detail
     {
-        template<typename ForwardIterator, typename Compare, typename Projection>
-        auto exc_probe_algo(ForwardIterator first, ForwardIterator last,
-                            cppsort::detail::difference_type_t<ForwardIterator> size,
-                            Compare compare, Projection projection)
+        // iterators holds the iterators of [first, last) sorted
+        // on the values they point to, size must be at least 2
+        template<typename ForwardIterator, typename SortedIterator,
+                 typename Compare, typename Projection>
+        auto exc_from_sorted_iterators(ForwardIterator first, ForwardIterator last,
+                                       cppsort::detail::difference_type_t<ForwardIterator> size,
+                                       SortedIterator iterators,
+                                       Compare compare, Projection projection)
             -> ::cppsort::detail::difference_type_t<ForwardIterator>
         {
             using difference_type = ::cppsort::detail::difference_type_t<ForwardIterator>;
             auto&& comp = utility::as_function(compare);
             auto&& proj = utility::as_function(projection);
 
-            if (size < 2) {
-                return 0;
-            }
-
-            ////////////////////////////////////////////////////////////
-            // Indirectly sort the iterators
-
-            // Copy the iterators in a vector
-            cppsort::detail::immovable_vector<ForwardIterator> iterators(size);
-            for (auto it = first; it != last; ++it) {
-                iterators.emplace_back(it);
-            }
-
-            // Sort the iterators on pointed values
-            cppsort::detail::pdqsort(
-                iterators.begin(), iterators.end(),
-                compare, utility::indirect{} | projection
-            );
-
             ////////////////////////////////////////////////////////////
             // Count the number of cycles
 
@@ -106,6 +91,35 @@ namespace probe
             return size - cycles;
         }
 
+        template<typename ForwardIterator, typename Compare, typename Projection>
+        auto exc_probe_algo(ForwardIterator first, ForwardIterator last,
+                            cppsort::detail::difference_type_t<ForwardIterator> size,
+                            Compare compare, Projection projection)
+            -> ::cppsort::detail::difference_type_t<ForwardIterator>
+        {
+            if (size < 2) {
+                return 0;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Indirectly sort the iterators
+
+            // Copy the iterators in a vector
+            cppsort::detail::immovable_vector<ForwardIterator> iterators(size);
+            for (auto it = first; it != last; ++it) {
+                iterators.emplace_back(it);
+            }
+
+            // Sort the iterators on pointed values
+            cppsort::detail::pdqsort(
+                iterators.begin(), iterators.end(),
+                compare, utility::indirect{} | projection
+            );
+
+            return exc_from_sorted_iterators(first, last, size, iterators.begin(),
+                                             std::move(compare), std::move(projection));
+        }
+
         struct exc_impl
         {
             template<
@@ -28,16 +28,40 @@ namespace probe
 {
     namespace detail
     {
-        template<typename ForwardIterator, typename Compare, typename Projection>
-        auto ham_probe_algo(ForwardIterator first, ForwardIterator last,
-                            cppsort::detail::difference_type_t<ForwardIterator> size,
-                            Compare compare, Projection projection)
+        // iterators holds the iterators of [first, last) sorted
+        // on the values they point to, size must be at least 2
+        template<typename ForwardIterator, typename SortedIterator,
+                 typename Compare, typename Projection>
+        auto ham_from_sorted_iterators(ForwardIterator first, ForwardIterator,
+                                       cppsort::detail::difference_type_t<ForwardIterator> size,
+                                       SortedIterator iterators,
+                                       Compare compare, Projection projection)
             -> ::cppsort::detail::difference_type_t<ForwardIterator>
         {
             using difference_type = ::cppsort::detail::difference_type_t<ForwardIterator>;
             auto&& comp = utility::as_function(compare);
             auto&& proj = utility::as_function(projection);
 
+            ////////////////////////////////////////////////////////////
+            // Count the number of values not in place
+
+            difference_type count = 0;
+            for (auto it = iterators ; it != iterators + size ; ++it) {
+                if (comp(proj(*first), proj(**it)) ||
+                    comp(proj(**it), proj(*first))) {
+                    ++count;
+                }
+                ++first;
+            }
+            return count;
+        }
+
+        template<typename ForwardIterator, typename Compare, typename Projection>
+        auto ham_probe_algo(ForwardIterator first, ForwardIterator last,
+                            cppsort::detail::difference_type_t<ForwardIterator> size,
+                            Compare compare, Projection projection)
+            -> ::cppsort::detail::difference_type_t<ForwardIterator>
+        {
             if (size < 2) {
                 return 0;
             }
@@ -57,18 +81,8 @@ namespace probe
                 compare, utility::indirect{} | projection
             );
 
-            ////////////////////////////////////////////////////////////
-            // Count the number of values not in place
-
-            difference_type count = 0;
-            for (auto&& it: iterators) {
-                if (comp(proj(*first), proj(*it)) ||
-                    comp(proj(*it), proj(*first))) {
-                    ++count;
-                }
-                ++first;
-            }
-            return count;
+            return ham_from_sorted_iterators(first, last, size, iterators.begin(),
+                                             std::move(compare), std::move(projection));
         }
 
         struct ham_impl
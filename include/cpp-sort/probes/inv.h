@@ -10,15 +10,18 @@
 ////////////////////////////////////////////////////////////
 #include <functional>
 #include <iterator>
-#include <memory>
+#include <type_traits>
 #include <utility>
 #include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/functional.h>
 #include <cpp-sort/utility/size.h>
 #include <cpp-sort/utility/static_const.h>
 #include "../detail/count_inversions.h"
+#include "../detail/immovable_vector.h"
 #include "../detail/iterator_traits.h"
+#include "../detail/parallel_count_inversions.h"
 #include "../detail/type_traits.h"
 
 namespace cppsort
@@ -30,7 +33,7 @@ namespace probe
         template<typename ForwardIterator, typename Compare, typename Projection>
         auto inv_probe_algo(ForwardIterator first, ForwardIterator last,
                             cppsort::detail::difference_type_t<ForwardIterator> size,
-                            Compare compare, Projection projection)
+                            Compare compare, Projection projection, std::false_type)
             -> ::cppsort::detail::difference_type_t<ForwardIterator>
         {
             using difference_type = ::cppsort::detail::difference_type_t<ForwardIterator>;
@@ -39,21 +42,68 @@ namespace probe
                 return 0;
             }
 
-            auto iterators = std::make_unique<ForwardIterator[]>(size);
-            auto buffer = std::make_unique<ForwardIterator[]>(size);
-
-            auto store = iterators.get();
+            cppsort::detail::immovable_vector<ForwardIterator> iterators(size);
+            cppsort::detail::immovable_vector<ForwardIterator> buffer(size);
             for (auto it = first; it != last; ++it) {
-                *store++ = it;
+                iterators.emplace_back(it);
+                buffer.emplace_back(it);
             }
 
             return cppsort::detail::count_inversions<difference_type>(
-                iterators.get(), iterators.get() + size, buffer.get(),
+                iterators.begin(), iterators.end(), buffer.begin(),
                 std::move(compare),
                 utility::indirect{} | std::move(projection)
             );
         }
 
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto inv_probe_algo(RandomAccessIterator first, RandomAccessIterator last,
+                            cppsort::detail::difference_type_t<RandomAccessIterator> size,
+                            Compare compare, Projection projection, std::true_type)
+            -> ::cppsort::detail::difference_type_t<RandomAccessIterator>
+        {
+            using difference_type = ::cppsort::detail::difference_type_t<RandomAccessIterator>;
+            using value_type = cppsort::detail::projected_t<RandomAccessIterator, Projection>;
+            auto&& proj = utility::as_function(projection);
+
+            if (size < 2) {
+                return 0;
+            }
+
+            // Arithmetic values are cheap to copy: work on a copy of
+            // the projected values instead of iterators, which avoids
+            // an indirection per comparison and allows to count the
+            // inversions in parallel
+            cppsort::detail::immovable_vector<value_type> values(size);
+            cppsort::detail::immovable_vector<value_type> buffer(size);
+            for (auto it = first ; it != last ; ++it) {
+                values.emplace_back(proj(*it));
+                buffer.emplace_back(values.back());
+            }
+
+            return cppsort::detail::parallel_count_inversions<difference_type>(
+                values.begin(), values.end(), buffer.begin(),
+                std::move(compare)
+            );
+        }
+
+        template<typename ForwardIterator, typename Compare, typename Projection>
+        auto inv_probe_algo(ForwardIterator first, ForwardIterator last,
+                            cppsort::detail::difference_type_t<ForwardIterator> size,
+                            Compare compare, Projection projection)
+            -> ::cppsort::detail::difference_type_t<ForwardIterator>
+        {
+            using category = cppsort::detail::iterator_category_t<ForwardIterator>;
+            using value_type = cppsort::detail::projected_t<ForwardIterator, Projection>;
+            using use_values = cppsort::detail::conjunction<
+                std::is_base_of<std::random_access_iterator_tag, category>,
+                std::is_arithmetic<value_type>
+            >;
+            return inv_probe_algo(std::move(first), std::move(last), size,
+                                  std::move(compare), std::move(projection),
+                                  use_values{});
+        }
+
         struct inv_impl
         {
             template<
@@ -30,34 +30,19 @@ namespace probe
 {
     namespace detail
     {
-        template<typename ForwardIterator, typename Compare, typename Projection>
-        auto max_probe_algo(ForwardIterator first, ForwardIterator last,
-                            cppsort::detail::difference_type_t<ForwardIterator> size,
-                            Compare compare, Projection projection)
+        // iterators holds the iterators of [first, last) sorted
+        // on the values they point to, size must be at least 2
+        template<typename ForwardIterator, typename SortedIterator,
+                 typename Compare, typename Projection>
+        auto max_from_sorted_iterators(ForwardIterator first, ForwardIterator last,
+                                       cppsort::detail::difference_type_t<ForwardIterator> size,
+                                       SortedIterator iterators,
+                                       Compare compare, Projection projection)
             -> ::cppsort::detail::difference_type_t<ForwardIterator>
         {
             using difference_type = ::cppsort::detail::difference_type_t<ForwardIterator>;
             auto&& proj = utility::as_function(projection);
 
-            if (size < 2) {
-                return 0;
-            }
-
-            ////////////////////////////////////////////////////////////
-            // Indirectly sort the iterators
-
-            // Copy the iterators in a vector
-            cppsort::detail::immovable_vector<ForwardIterator> iterators(size);
-            for (auto it = first; it != last; ++it) {
-                iterators.emplace_back(it);
-            }
-
-            // Sort the iterators on pointed values
-            cppsort::detail::pdqsort(
-                iterators.begin(), iterators.end(),
-                compare, utility::indirect{} | projection
-            );
-
             ////////////////////////////////////////////////////////////
             // Maximum distance an element has to travel in order to
             // reach its sorted position
@@ -67,11 +52,11 @@ namespace probe
             for (auto it = first; it != last; ++it) {
                 // Find the range where *first belongs once sorted
                 auto rng = cppsort::detail::equal_range(
-                    iterators.begin(), iterators.end(), proj(*it),
+                    iterators, iterators + size, proj(*it),
                     compare, utility::indirect{} | projection
                 );
-                auto pos_min = rng.first - iterators.begin();
-                auto pos_max = rng.second - iterators.begin();
+                auto pos_min = rng.first - iterators;
+                auto pos_max = rng.second - iterators;
 
                 // If *first isn't into one of its sorted positions, computed the closest
                 if (it_pos < pos_min) {
@@ -85,6 +70,35 @@ namespace probe
             return max_dist;
         }
 
+        template<typename ForwardIterator, typename Compare, typename Projection>
+        auto max_probe_algo(ForwardIterator first, ForwardIterator last,
+                            cppsort::detail::difference_type_t<ForwardIterator> size,
+                            Compare compare, Projection projection)
+            -> ::cppsort::detail::difference_type_t<ForwardIterator>
+        {
+            if (size < 2) {
+                return 0;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Indirectly sort the iterators
+
+            // Copy the iterators in a vector
+            cppsort::detail::immovable_vector<ForwardIterator> iterators(size);
+            for (auto it = first; it != last; ++it) {
+                iterators.emplace_back(it);
+            }
+
+            // Sort the iterators on pointed values
+            cppsort::detail::pdqsort(
+                iterators.begin(), iterators.end(),
+                compare, utility::indirect{} | projection
+            );
+
+            return max_from_sorted_iterators(first, last, size, iterators.begin(),
+                                             std::move(compare), std::move(projection));
+        }
+
         struct max_impl
         {
             template<
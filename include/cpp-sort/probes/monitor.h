@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_PROBES_MONITOR_H_
+#define CPPSORT_PROBES_MONITOR_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <cpp-sort/probes/approx/estimate.h>
+#include <cpp-sort/probes/mono.h>
+#include <cpp-sort/probes/multi.h>
+#include <cpp-sort/probes/runs.h>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+
+namespace cppsort
+{
+namespace probe
+{
+    ////////////////////////////////////////////////////////////
+    // Online presortedness monitor
+    //
+    // Measures the presortedness of a sequence whose elements
+    // are pushed one at a time, without storing the whole
+    // sequence:
+    // - Runs and Mono are updated from the previous element in
+    //   constant time, the same way probe::multi does.
+    // - Dis only depends on the prefix maxima of the sequence:
+    //   the leftmost element greater than a new element is the
+    //   first prefix maximum greater than it, which is found
+    //   with a binary search. The distinct prefix maxima are
+    //   stored, which takes O(n) memory in the worst case, when
+    //   the sequence is strictly increasing.
+    // - Inv is estimated with a uniform reservoir sample of the
+    //   previous elements kept sorted: the proportion of the
+    //   sample greater than a new element estimates the number
+    //   of inversions it adds. The sample is a sorted vector, so
+    //   filling it and replacing its elements move O(k) elements:
+    //   a push costs O(log k + k^2/n) on average, which is only
+    //   O(log k) once n is much bigger than k^2.
+
+    template<
+        typename T,
+        typename Compare = std::less<>,
+        typename Projection = utility::identity
+    >
+    class monitor
+    {
+        public:
+
+            using difference_type = std::ptrdiff_t;
+
+            ////////////////////////////////////////////////////////////
+            // Construction
+
+            monitor() = default;
+
+            explicit monitor(Compare compare, Projection projection={}):
+                compare_(std::move(compare)),
+                projection_(std::move(projection))
+            {}
+
+            explicit monitor(std::size_t sample_budget,
+                             Compare compare={}, Projection projection={}):
+                compare_(std::move(compare)),
+                projection_(std::move(projection)),
+                sample_budget_(sample_budget != 0 ? sample_budget : 1)
+            {}
+
+            ////////////////////////////////////////////////////////////
+            // Modifiers
+
+            auto push(const T& value)
+                -> void
+            {
+                auto&& comp = utility::as_function(compare_);
+                auto&& proj = utility::as_function(projection_);
+
+                // Runs and Mono
+                if (previous_) {
+                    bool next_less = comp(proj(value), proj(*previous_));
+                    bool current_less = not next_less && comp(proj(*previous_), proj(value));
+                    runs_.step(next_less, current_less);
+                    mono_.step(next_less, current_less);
+                    *previous_ = value;
+                } else {
+                    previous_ = std::make_unique<T>(value);
+                }
+
+                // Dis: the prefix maxima are strictly increasing, an element
+                // equivalent to the last one is never the leftmost element
+                // greater than a later element, so it isn't stored
+                auto it = std::upper_bound(
+                    maxima_.begin(), maxima_.end(), proj(value),
+                    [&](const auto& lhs, const auto& rhs) { return comp(lhs, proj(rhs.first)); }
+                );
+                if (it == maxima_.end()) {
+                    if (maxima_.empty() || comp(proj(maxima_.back().first), proj(value))) {
+                        maxima_.emplace_back(value, size_);
+                    }
+                } else {
+                    dis_ = (std::max)(dis_, size_ - it->second);
+                }
+
+                push_sample(value);
+                ++size_;
+            }
+
+            auto clear()
+                -> void
+            {
+                previous_.reset();
+                runs_ = runs_part{};
+                mono_ = mono_part{};
+                maxima_.clear();
+                dis_ = 0;
+                sample_.clear();
+                inv_ = 0.0;
+                inv_error_ = 0.0;
+                size_ = 0;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Measures of presortedness
+
+            auto size() const
+                -> difference_type
+            {
+                return size_;
+            }
+
+            auto runs() const
+                -> difference_type
+            {
+                return runs_.count;
+            }
+
+            auto mono() const
+                -> difference_type
+            {
+                return mono_.count;
+            }
+
+            auto dis() const
+                -> difference_type
+            {
+                return dis_;
+            }
+
+            auto inv() const
+                -> approx::estimate<difference_type>
+            {
+                return {
+                    static_cast<difference_type>(std::llround(inv_)),
+                    static_cast<difference_type>(std::ceil(inv_error_))
+                };
+            }
+
+        private:
+
+            using runs_part = detail::multi_part<sorter_facade<detail::runs_impl>, difference_type>;
+            using mono_part = detail::multi_part<sorter_facade<detail::mono_impl>, difference_type>;
+
+            auto push_sample(const T& value)
+                -> void
+            {
+                auto&& comp = utility::as_function(compare_);
+                auto&& proj = utility::as_function(projection_);
+
+                // Number of sampled elements greater than value
+                auto it = std::upper_bound(
+                    sample_.begin(), sample_.end(), proj(value),
+                    [&](const auto& lhs, const auto& rhs) { return comp(lhs, proj(rhs)); }
+                );
+                auto nb_greater = sample_.end() - it;
+
+                if (sample_.size() < sample_budget_) {
+                    // The sample holds every previous element, inserting
+                    // the new one moves O(k) elements
+                    inv_ += static_cast<double>(nb_greater);
+                    sample_.insert(it, value);
+                    return;
+                }
+
+                auto nb_samples = static_cast<double>(sample_.size());
+                inv_ += static_cast<double>(nb_greater) / nb_samples * static_cast<double>(size_);
+                // sqrt(ln(2 / 0.05) / 2), see approx::detail::sampling_error
+                inv_error_ += 1.3581015157 / std::sqrt(nb_samples) * static_cast<double>(size_);
+
+                // Algorithm R: the new element replaces a random element
+                // of the sample with a probability of budget / (size + 1),
+                // which moves O(k) elements to keep the sample sorted
+                auto pos = approx::detail::random_index(size_ + 1);
+                if (static_cast<std::size_t>(pos) < sample_budget_) {
+                    auto removed = sample_.begin() + approx::detail::random_index(sample_.end() - sample_.begin());
+                    if (removed < it) {
+                        std::move(removed + 1, it, removed);
+                        *(it - 1) = value;
+                    } else {
+                        std::move_backward(it, removed, removed + 1);
+                        *it = value;
+                    }
+                }
+            }
+
+            Compare compare_;
+            Projection projection_;
+            std::size_t sample_budget_ = approx::default_sample_budget;
+
+            // Number of elements pushed
+            difference_type size_ = 0;
+
+            // Runs and Mono
+            std::unique_ptr<T> previous_;
+            runs_part runs_;
+            mono_part mono_;
+
+            // Prefix maxima and their positions
+            std::vector<std::pair<T, difference_type>> maxima_;
+            difference_type dis_ = 0;
+
+            // Reservoir sample kept sorted
+            std::vector<T> sample_;
+            double inv_ = 0.0;
+            double inv_error_ = 0.0;
+    };
+}}
+
+#endif // CPPSORT_PROBES_MONITOR_H_
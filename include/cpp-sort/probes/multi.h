@@ -0,0 +1,370 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_PROBES_MULTI_H_
+#define CPPSORT_PROBES_MULTI_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/probes/block.h>
+#include <cpp-sort/probes/exc.h>
+#include <cpp-sort/probes/ham.h>
+#include <cpp-sort/probes/max.h>
+#include <cpp-sort/probes/mono.h>
+#include <cpp-sort/probes/runs.h>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/size.h>
+#include "../detail/any_all.h"
+#include "../detail/immovable_vector.h"
+#include "../detail/iterator_traits.h"
+#include "../detail/pdqsort.h"
+#include "../detail/type_traits.h"
+
+namespace cppsort
+{
+namespace probe
+{
+    namespace detail
+    {
+        ////////////////////////////////////////////////////////////
+        // Parts of the fused computation
+        //
+        // Every probe passed to multi is associated with a part that
+        // says how its measure is computed:
+        // - Measures that only look at adjacent pairs of elements
+        //   are updated during a single pass over the collection.
+        // - Measures that compare the collection to its sorted
+        //   permutation share a single buffer of iterators sorted
+        //   once, which is filled during the same pass.
+        // - Other measures are computed separately by their probe.
+
+        // Measures computed from the sorted iterators
+
+        template<typename Probe>
+        struct needs_sorted_iterators:
+            std::false_type
+        {};
+
+        template<>
+        struct needs_sorted_iterators<sorter_facade<block_impl>>:
+            std::true_type
+        {};
+
+        template<>
+        struct needs_sorted_iterators<sorter_facade<exc_impl>>:
+            std::true_type
+        {};
+
+        template<>
+        struct needs_sorted_iterators<sorter_facade<ham_impl>>:
+            std::true_type
+        {};
+
+        template<>
+        struct needs_sorted_iterators<sorter_facade<max_impl>>:
+            std::true_type
+        {};
+
+        template<
+            typename Probe,
+            typename Difference,
+            bool = needs_sorted_iterators<Probe>::value
+        >
+        struct multi_part
+        {
+            static constexpr bool uses_pairs = false;
+            static constexpr bool uses_sorted_iterators = false;
+
+            auto step(bool /* next_less */, bool /* current_less */)
+                -> void
+            {}
+
+            template<typename ForwardIterator, typename SortedIterator,
+                     typename Compare, typename Projection>
+            auto result(const Probe& probe, ForwardIterator first, ForwardIterator last,
+                        Difference /* size */, SortedIterator /* iterators */,
+                        Compare compare, Projection projection) const
+                -> decltype(auto)
+            {
+                return probe(first, last, std::move(compare), std::move(projection));
+            }
+        };
+
+        // Number of step-downs
+        template<typename Difference>
+        struct multi_part<sorter_facade<runs_impl>, Difference, false>
+        {
+            static constexpr bool uses_pairs = true;
+            static constexpr bool uses_sorted_iterators = false;
+
+            Difference count = 0;
+
+            auto step(bool next_less, bool /* current_less */)
+                -> void
+            {
+                count += next_less;
+            }
+
+            template<typename Probe, typename... Args>
+            auto result(const Probe&, Args&&...) const
+                -> Difference
+            {
+                return count;
+            }
+        };
+
+        // Number of non-increasing and non-decreasing runs minus one,
+        // follows the same logic as mono_impl one pair at a time
+        template<typename Difference>
+        struct multi_part<sorter_facade<mono_impl>, Difference, false>
+        {
+            static constexpr bool uses_pairs = true;
+            static constexpr bool uses_sorted_iterators = false;
+
+            enum struct run_kind { none, ascending, descending };
+
+            Difference count = 0;
+            run_kind current_run = run_kind::none;
+
+            auto step(bool next_less, bool current_less)
+                -> void
+            {
+                switch (current_run) {
+                    case run_kind::none:
+                        if (current_less) {
+                            current_run = run_kind::ascending;
+                        } else if (next_less) {
+                            current_run = run_kind::descending;
+                        }
+                        break;
+                    case run_kind::ascending:
+                        if (next_less) {
+                            ++count;
+                            current_run = run_kind::none;
+                        }
+                        break;
+                    case run_kind::descending:
+                        if (current_less) {
+                            ++count;
+                            current_run = run_kind::none;
+                        }
+                        break;
+                }
+            }
+
+            template<typename Probe, typename... Args>
+            auto result(const Probe&, Args&&...) const
+                -> Difference
+            {
+                return count;
+            }
+        };
+
+        // Dispatch to the algorithm of every measure
+
+        template<typename... Args>
+        auto from_sorted_iterators(const sorter_facade<block_impl>&, Args&&... args)
+            -> decltype(auto)
+        {
+            return block_from_sorted_iterators(std::forward<Args>(args)...);
+        }
+
+        template<typename... Args>
+        auto from_sorted_iterators(const sorter_facade<exc_impl>&, Args&&... args)
+            -> decltype(auto)
+        {
+            return exc_from_sorted_iterators(std::forward<Args>(args)...);
+        }
+
+        template<typename... Args>
+        auto from_sorted_iterators(const sorter_facade<ham_impl>&, Args&&... args)
+            -> decltype(auto)
+        {
+            return ham_from_sorted_iterators(std::forward<Args>(args)...);
+        }
+
+        template<typename... Args>
+        auto from_sorted_iterators(const sorter_facade<max_impl>&, Args&&... args)
+            -> decltype(auto)
+        {
+            return max_from_sorted_iterators(std::forward<Args>(args)...);
+        }
+
+        template<typename Probe, typename Difference>
+        struct multi_part<Probe, Difference, true>
+        {
+            static constexpr bool uses_pairs = false;
+            static constexpr bool uses_sorted_iterators = true;
+
+            auto step(bool /* next_less */, bool /* current_less */)
+                -> void
+            {}
+
+            template<typename ForwardIterator, typename SortedIterator,
+                     typename Compare, typename Projection>
+            auto result(const Probe& probe, ForwardIterator first, ForwardIterator last,
+                        Difference size, SortedIterator iterators,
+                        Compare compare, Projection projection) const
+                -> Difference
+            {
+                if (size < 2) {
+                    return 0;
+                }
+                return from_sorted_iterators(probe, first, last, size, iterators,
+                                             std::move(compare), std::move(projection));
+            }
+        };
+
+        ////////////////////////////////////////////////////////////
+        // Fused computation
+
+        template<typename... Probes>
+        struct multi_impl
+        {
+            private:
+
+                std::tuple<Probes...> probes;
+
+                template<typename ForwardIterator>
+                using parts_t = std::tuple<
+                    multi_part<
+                        cppsort::detail::remove_cvref_t<Probes>,
+                        cppsort::detail::difference_type_t<ForwardIterator>
+                    >...
+                >;
+
+                template<typename ForwardIterator, typename Compare,
+                         typename Projection, std::size_t... Indices>
+                auto multi_probe_algo(ForwardIterator first, ForwardIterator last,
+                                      cppsort::detail::difference_type_t<ForwardIterator> size,
+                                      Compare compare, Projection projection,
+                                      std::index_sequence<Indices...>) const
+                    -> decltype(auto)
+                {
+                    using parts_type = parts_t<ForwardIterator>;
+                    constexpr bool uses_pairs = cppsort::detail::any(
+                        std::tuple_element_t<Indices, parts_type>::uses_pairs...
+                    );
+                    constexpr bool uses_sorted_iterators = cppsort::detail::any(
+                        std::tuple_element_t<Indices, parts_type>::uses_sorted_iterators...
+                    );
+                    auto&& comp = utility::as_function(compare);
+                    auto&& proj = utility::as_function(projection);
+
+                    parts_type parts;
+                    cppsort::detail::immovable_vector<ForwardIterator> iterators(
+                        uses_sorted_iterators ? size : 0
+                    );
+
+                    // Single pass over the collection
+                    if ((uses_pairs || uses_sorted_iterators) && first != last) {
+                        auto current = first;
+                        for (auto next = std::next(first) ; next != last ; ++next) {
+                            if (uses_sorted_iterators) {
+                                iterators.emplace_back(current);
+                            }
+                            if (uses_pairs) {
+                                bool next_less = comp(proj(*next), proj(*current));
+                                bool current_less = not next_less && comp(proj(*current), proj(*next));
+                                (void) std::initializer_list<int>{
+                                    (std::get<Indices>(parts).step(next_less, current_less), 0)...
+                                };
+                            }
+                            current = next;
+                        }
+                        if (uses_sorted_iterators) {
+                            iterators.emplace_back(current);
+                        }
+                    }
+
+                    if (uses_sorted_iterators && size > 1) {
+                        cppsort::detail::pdqsort(
+                            iterators.begin(), iterators.end(),
+                            compare, utility::indirect{} | projection
+                        );
+                    }
+
+                    return std::make_tuple(
+                        std::get<Indices>(parts).result(
+                            std::get<Indices>(probes), first, last, size,
+                            iterators.begin(), compare, projection
+                        )...
+                    );
+                }
+
+            public:
+
+                multi_impl() = default;
+
+                constexpr explicit multi_impl(Probes... probes):
+                    probes(std::move(probes)...)
+                {}
+
+                template<
+                    typename ForwardIterable,
+                    typename Compare = std::less<>,
+                    typename Projection = utility::identity,
+                    typename = cppsort::detail::enable_if_t<
+                        is_projection_v<Projection, ForwardIterable, Compare>
+                    >
+                >
+                auto operator()(ForwardIterable&& iterable,
+                                Compare compare={}, Projection projection={}) const
+                    -> decltype(auto)
+                {
+                    return multi_probe_algo(std::begin(iterable), std::end(iterable),
+                                            utility::size(iterable),
+                                            std::move(compare), std::move(projection),
+                                            std::index_sequence_for<Probes...>{});
+                }
+
+                template<
+                    typename ForwardIterator,
+                    typename Compare = std::less<>,
+                    typename Projection = utility::identity,
+                    typename = cppsort::detail::enable_if_t<
+                        is_projection_iterator_v<Projection, ForwardIterator, Compare>
+                    >
+                >
+                auto operator()(ForwardIterator first, ForwardIterator last,
+                                Compare compare={}, Projection projection={}) const
+                    -> decltype(auto)
+                {
+                    auto size = std::distance(first, last);
+                    return multi_probe_algo(std::move(first), std::move(last), size,
+                                            std::move(compare), std::move(projection),
+                                            std::index_sequence_for<Probes...>{});
+                }
+        };
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Computes several measures of presortedness at once and
+    // returns them in a std::tuple, in the order of the probes
+
+    template<typename... Probes>
+    struct multi:
+        sorter_facade<detail::multi_impl<cppsort::detail::remove_cvref_t<Probes>...>>
+    {
+        multi() = default;
+
+        constexpr explicit multi(Probes... probes):
+            sorter_facade<detail::multi_impl<cppsort::detail::remove_cvref_t<Probes>...>>(
+                std::move(probes)...
+            )
+        {}
+    };
+}}
+
+#endif // CPPSORT_PROBES_MULTI_H_
@@ -14,7 +14,6 @@
 #include <new>
 #include <numeric>
 #include <utility>
-#include <vector>
 #include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorter_traits.h>
 #include <cpp-sort/utility/as_function.h>
@@ -116,7 +115,8 @@ namespace probe
             //       twice as slow. Comments in the code contain the lines
             //       required to reduce the search space again.
 
-            std::vector<difference_type> cross(size, 0);
+            cppsort::detail::immovable_vector<difference_type> cross(size);
+            cross.fill_back(size, 0);
 
             auto prev_bounds = cppsort::detail::equal_range(
                 iterators.begin(), iterators.end(), proj(*first),
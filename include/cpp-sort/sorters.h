@@ -9,6 +9,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <cpp-sort/sorters/adaptive_shivers_sorter.h>
+#include <cpp-sort/sorters/auto_sorter.h>
 #include <cpp-sort/sorters/block_sorter.h>
 #include <cpp-sort/sorters/cartesian_tree_sorter.h>
 #include <cpp-sort/sorters/counting_sorter.h>
@@ -18,9 +19,21 @@
 #include <cpp-sort/sorters/grail_sorter.h>
 #include <cpp-sort/sorters/heap_sorter.h>
 #include <cpp-sort/sorters/insertion_sorter.h>
+#include <cpp-sort/sorters/lsd_radix_sorter.h>
 #include <cpp-sort/sorters/mel_sorter.h>
 #include <cpp-sort/sorters/merge_insertion_sorter.h>
 #include <cpp-sort/sorters/merge_sorter.h>
+#include <cpp-sort/sorters/multikey_quick_sorter.h>
+#include <cpp-sort/sorters/parallel_counting_sorter.h>
+#include <cpp-sort/sorters/parallel_grail_sorter.h>
+#include <cpp-sort/sorters/parallel_merge_sorter.h>
+#include <cpp-sort/sorters/parallel_pdq_sorter.h>
+#include <cpp-sort/sorters/parallel_ska_sorter.h>
+#include <cpp-sort/sorters/parallel_spin_sorter.h>
+#include <cpp-sort/sorters/parallel_spread_sorter.h>
+#include <cpp-sort/sorters/parallel_tim_sorter.h>
+#include <cpp-sort/sorters/parallel_verge_sorter.h>
+#include <cpp-sort/sorters/parallel_wiki_sorter.h>
 #include <cpp-sort/sorters/pdq_sorter.h>
 #include <cpp-sort/sorters/poplar_sorter.h>
 #include <cpp-sort/sorters/quick_merge_sorter.h>
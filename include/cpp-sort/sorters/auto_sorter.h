@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_SORTERS_AUTO_SORTER_H_
+#define CPPSORT_SORTERS_AUTO_SORTER_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/probes/approx/mono.h>
+#include <cpp-sort/probes/approx/rem.h>
+#include <cpp-sort/probes/approx/runs.h>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/sorters/counting_sorter.h>
+#include <cpp-sort/sorters/drop_merge_sorter.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <cpp-sort/sorters/ska_sorter.h>
+#include <cpp-sort/sorters/tim_sorter.h>
+#include <cpp-sort/sorters/verge_sorter.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/static_const.h>
+#include "../detail/iterator_traits.h"
+#include "../detail/ska_sort.h"
+#include "../detail/type_traits.h"
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // Thresholds used to pick an algorithm
+
+    struct auto_sorter_thresholds
+    {
+        // Below this size, the algorithm is picked from the types
+        // alone without examining the collection
+        std::size_t small_size = 2048;
+
+        // Number of elements examined by the probes
+        std::size_t sample_budget = 1024;
+
+        // counting_sorter is used when the range of the sampled
+        // values is smaller than the size times this factor
+        double counting_range_factor = 1.0;
+
+        // tim_sorter is used when the estimated proportion of adjacent
+        // pairs that are step-downs is at most this value, or at least
+        // one minus this value
+        double tim_max_runs = 0.001;
+
+        // drop_merge_sorter is used when the estimated proportion of
+        // elements to remove to get a sorted collection is at most
+        // this value
+        double drop_merge_max_rem = 0.25;
+
+        // verge_sorter is used when the estimated number of monotonic
+        // runs is at most this proportion of the size, which means that
+        // some long runs can be found amidst disorder
+        double verge_max_mono = 0.25;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Sorter
+
+    namespace detail
+    {
+        struct auto_sorter_impl
+        {
+            private:
+
+                auto_sorter_thresholds thresholds;
+
+                ////////////////////////////////////////////////////////////
+                // Algorithms picked from the types
+
+                template<typename RandomAccessIterator, typename Compare, typename Projection>
+                static auto radix_or_pdq_sort(RandomAccessIterator first, RandomAccessIterator last,
+                                              Compare compare, Projection projection, std::true_type)
+                    -> void
+                {
+                    ska_sorter{}(std::move(first), std::move(last),
+                                 std::move(compare), std::move(projection));
+                }
+
+                template<typename RandomAccessIterator, typename Compare, typename Projection>
+                static auto radix_or_pdq_sort(RandomAccessIterator first, RandomAccessIterator last,
+                                              Compare compare, Projection projection, std::false_type)
+                    -> void
+                {
+                    pdq_sorter{}(std::move(first), std::move(last),
+                                 std::move(compare), std::move(projection));
+                }
+
+                // Returns whether the collection was sorted with counting_sorter,
+                // which happens when the sampled values are dense enough
+                template<typename RandomAccessIterator, typename Compare, typename Projection>
+                auto try_counting_sort(RandomAccessIterator first, RandomAccessIterator last,
+                                       Compare compare, Projection projection, std::true_type) const
+                    -> bool
+                {
+                    using difference_type = difference_type_t<RandomAccessIterator>;
+                    auto size = last - first;
+                    auto nb_samples = (std::min)((std::max)(thresholds.sample_budget, std::size_t(1)),
+                                                 static_cast<std::size_t>(size));
+                    auto step = size / static_cast<difference_type>(nb_samples);
+
+                    auto min = to_unsigned_or_bool(*first);
+                    auto max = min;
+                    for (auto it = first + step ; it < last ; it += step) {
+                        auto value = to_unsigned_or_bool(*it);
+                        if (value < min) min = value;
+                        if (max < value) max = value;
+                    }
+
+                    if (static_cast<double>(max - min)
+                            >= thresholds.counting_range_factor * static_cast<double>(size)) {
+                        return false;
+                    }
+                    counting_sorter{}(std::move(first), std::move(last),
+                                      std::move(compare), std::move(projection));
+                    return true;
+                }
+
+                template<typename RandomAccessIterator, typename Compare, typename Projection>
+                auto try_counting_sort(RandomAccessIterator, RandomAccessIterator,
+                                       Compare, Projection, std::false_type) const
+                    -> bool
+                {
+                    return false;
+                }
+
+                ////////////////////////////////////////////////////////////
+                // Dispatch on iterator category
+
+                template<typename BidirectionalIterator, typename Compare, typename Projection>
+                auto auto_sort(BidirectionalIterator first, BidirectionalIterator last,
+                               Compare compare, Projection projection,
+                               std::bidirectional_iterator_tag) const
+                    -> void
+                {
+                    // The probes need random-access iterators, vergesort
+                    // still finds the big runs of bidirectional collections
+                    verge_sorter{}(std::move(first), std::move(last),
+                                   std::move(compare), std::move(projection));
+                }
+
+                template<typename RandomAccessIterator, typename Compare, typename Projection>
+                auto auto_sort(RandomAccessIterator first, RandomAccessIterator last,
+                               Compare compare, Projection projection,
+                               std::random_access_iterator_tag) const
+                    -> void
+                {
+                    using can_radix_sort = std::integral_constant<bool,
+                        is_comparison_projection_sorter_iterator_v<
+                            ska_sorter, RandomAccessIterator, Compare, Projection
+                        >
+                    >;
+                    using can_counting_sort = std::integral_constant<bool,
+                        is_comparison_projection_sorter_iterator_v<
+                            counting_sorter, RandomAccessIterator, Compare, Projection
+                        >
+                    >;
+
+                    auto size = last - first;
+                    if (size < 2 || static_cast<std::size_t>(size) < thresholds.small_size) {
+                        radix_or_pdq_sort(std::move(first), std::move(last),
+                                          std::move(compare), std::move(projection),
+                                          can_radix_sort{});
+                        return;
+                    }
+
+                    if (try_counting_sort(first, last, compare, projection, can_counting_sort{})) {
+                        return;
+                    }
+
+                    // Almost sorted in either direction
+                    auto runs = probe::approx::runs_t(thresholds.sample_budget)(
+                        first, last, compare, projection
+                    );
+                    double runs_ratio = static_cast<double>(runs.value) / static_cast<double>(size - 1);
+                    if (runs_ratio <= thresholds.tim_max_runs || runs_ratio >= 1.0 - thresholds.tim_max_runs) {
+                        tim_sorter{}(std::move(first), std::move(last),
+                                     std::move(compare), std::move(projection));
+                        return;
+                    }
+
+                    // Few elements out of place
+                    auto rem = probe::approx::rem_t(thresholds.sample_budget)(
+                        first, last, compare, projection
+                    );
+                    double rem_ratio = static_cast<double>(rem.value) / static_cast<double>(size);
+                    if (rem_ratio <= thresholds.drop_merge_max_rem) {
+                        drop_merge_sorter{}(std::move(first), std::move(last),
+                                            std::move(compare), std::move(projection));
+                        return;
+                    }
+
+                    // Long monotonic runs amidst disorder
+                    auto mono = probe::approx::mono_t(thresholds.sample_budget)(
+                        first, last, compare, projection
+                    );
+                    double mono_ratio = static_cast<double>(mono.value) / static_cast<double>(size);
+                    if (mono_ratio <= thresholds.verge_max_mono) {
+                        verge_sorter{}(std::move(first), std::move(last),
+                                       std::move(compare), std::move(projection));
+                        return;
+                    }
+
+                    radix_or_pdq_sort(std::move(first), std::move(last),
+                                      std::move(compare), std::move(projection),
+                                      can_radix_sort{});
+                }
+
+            public:
+
+                constexpr explicit auto_sorter_impl(auto_sorter_thresholds thresholds={}) noexcept:
+                    thresholds(thresholds)
+                {}
+
+                template<
+                    typename BidirectionalIterator,
+                    typename Compare = std::less<>,
+                    typename Projection = utility::identity,
+                    typename = detail::enable_if_t<
+                        is_projection_iterator_v<Projection, BidirectionalIterator, Compare>
+                    >
+                >
+                auto operator()(BidirectionalIterator first, BidirectionalIterator last,
+                                Compare compare={}, Projection projection={}) const
+                    -> void
+                {
+                    static_assert(
+                        std::is_base_of<
+                            iterator_category,
+                            iterator_category_t<BidirectionalIterator>
+                        >::value,
+                        "auto_sorter requires at least bidirectional iterators"
+                    );
+
+                    auto_sort(std::move(first), std::move(last),
+                              std::move(compare), std::move(projection),
+                              iterator_category_t<BidirectionalIterator>{});
+                }
+
+                ////////////////////////////////////////////////////////////
+                // Sorter traits
+
+                using iterator_category = std::bidirectional_iterator_tag;
+                using is_always_stable = std::false_type;
+        };
+    }
+
+    struct auto_sorter:
+        sorter_facade<detail::auto_sorter_impl>
+    {
+        auto_sorter() = default;
+
+        constexpr explicit auto_sorter(auto_sorter_thresholds thresholds) noexcept:
+            sorter_facade<detail::auto_sorter_impl>(thresholds)
+        {}
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Sort function
+
+    namespace
+    {
+        constexpr auto&& auto_sort
+            = utility::static_const<auto_sorter>::value;
+    }
+}
+
+#endif // CPPSORT_SORTERS_AUTO_SORTER_H_
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_SORTERS_LSD_RADIX_SORTER_H_
+#define CPPSORT_SORTERS_LSD_RADIX_SORTER_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/buffer.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/static_const.h>
+#include "../detail/iterator_traits.h"
+#include "../detail/lsd_radix_sort.h"
+#include "../detail/type_traits.h"
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // Sorter
+
+    namespace detail
+    {
+        template<typename BufferProvider>
+        struct lsd_radix_sorter_impl
+        {
+            template<
+                typename RandomAccessIterator,
+                typename Projection = utility::identity,
+                typename = detail::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator>
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Projection projection={}) const
+                -> detail::enable_if_t<detail::is_lsd_radix_sortable_v<
+                    projected_t<RandomAccessIterator, Projection>
+                >>
+            {
+                static_assert(
+                    std::is_base_of<
+                        iterator_category,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "lsd_radix_sorter requires at least random-access iterators"
+                );
+
+                lsd_radix_sort<BufferProvider>(std::move(first), std::move(last),
+                                               std::move(projection));
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Sorter traits
+
+            using iterator_category = std::random_access_iterator_tag;
+            using is_always_stable = std::false_type;
+        };
+    }
+
+    template<
+        typename BufferProvider = utility::dynamic_buffer<utility::identity>
+    >
+    struct lsd_radix_sorter:
+        sorter_facade<detail::lsd_radix_sorter_impl<BufferProvider>>
+    {};
+
+    ////////////////////////////////////////////////////////////
+    // Sort function
+
+    namespace
+    {
+        constexpr auto&& lsd_radix_sort
+            = utility::static_const<lsd_radix_sorter<>>::value;
+    }
+}
+
+#endif // CPPSORT_SORTERS_LSD_RADIX_SORTER_H_
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_SORTERS_MULTIKEY_QUICK_SORTER_H_
+#define CPPSORT_SORTERS_MULTIKEY_QUICK_SORTER_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/static_const.h>
+#include <cpp-sort/utility/string_key_extractor.h>
+#include "../detail/iterator_traits.h"
+#include "../detail/multikey_quicksort.h"
+#include "../detail/type_traits.h"
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // Sorter
+
+    namespace detail
+    {
+        struct multikey_quick_sorter_impl
+        {
+            template<
+                typename RandomAccessIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = detail::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator, Compare> &&
+                    utility::has_string_key_extractor_v<
+                        Compare,
+                        projected_t<RandomAccessIterator, Projection>
+                    >
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> void
+            {
+                static_assert(
+                    std::is_base_of<
+                        iterator_category,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "multikey_quick_sorter requires at least random-access iterators"
+                );
+
+                using extractor_type = utility::string_key_extractor<
+                    remove_cvref_t<Compare>,
+                    projected_t<RandomAccessIterator, Projection>
+                >;
+                extractor_type extractor(compare);
+                multikey_quicksort(std::move(first), std::move(last),
+                                   extractor, std::move(projection));
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Sorter traits
+
+            using iterator_category = std::random_access_iterator_tag;
+            using is_always_stable = std::false_type;
+        };
+    }
+
+    struct multikey_quick_sorter:
+        sorter_facade<detail::multikey_quick_sorter_impl>
+    {};
+
+    ////////////////////////////////////////////////////////////
+    // Sort function
+
+    namespace
+    {
+        constexpr auto&& multikey_quick_sort
+            = utility::static_const<multikey_quick_sorter>::value;
+    }
+}
+
+#endif // CPPSORT_SORTERS_MULTIKEY_QUICK_SORTER_H_
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_SORTERS_PARALLEL_SPREAD_SORTER_H_
+#define CPPSORT_SORTERS_PARALLEL_SPREAD_SORTER_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cpp-sort/adapters/hybrid_adapter.h>
+#include <cpp-sort/sorters/spread_sorter/parallel_float_spread_sorter.h>
+#include <cpp-sort/sorters/spread_sorter/parallel_integer_spread_sorter.h>
+#include <cpp-sort/sorters/spread_sorter/parallel_string_spread_sorter.h>
+#include <cpp-sort/utility/static_const.h>
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // Sorter
+
+    struct parallel_spread_sorter:
+        hybrid_adapter<
+            parallel_integer_spread_sorter,
+            parallel_float_spread_sorter,
+            parallel_string_spread_sorter
+        >
+    {};
+
+    ////////////////////////////////////////////////////////////
+    // Sort function
+
+    namespace
+    {
+        constexpr auto&& parallel_spread_sort
+            = utility::static_const<parallel_spread_sorter>::value;
+    }
+}
+
+#endif // CPPSORT_SORTERS_PARALLEL_SPREAD_SORTER_H_
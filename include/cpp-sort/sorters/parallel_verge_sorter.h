@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_SORTERS_PARALLEL_VERGE_SORTER_H_
+#define CPPSORT_SORTERS_PARALLEL_VERGE_SORTER_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/adapters/stable_adapter.h>
+#include <cpp-sort/fwd.h>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/static_const.h>
+#include "../detail/iterator_traits.h"
+#include "../detail/parallel_vergesort.h"
+#include "../detail/type_traits.h"
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // Sorter implementation
+
+    namespace detail
+    {
+        template<bool Stable>
+        struct parallel_verge_sorter_impl
+        {
+            template<
+                typename RandomAccessIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = detail::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator, Compare>
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> void
+            {
+                static_assert(
+                    std::is_base_of<
+                        iterator_category,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "parallel_verge_sorter requires at least random-access iterators"
+                );
+
+                parallel_vergesort<Stable>(std::move(first), std::move(last),
+                                           std::move(compare), std::move(projection));
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Sorter traits
+
+            using iterator_category = std::random_access_iterator_tag;
+            using is_always_stable = std::integral_constant<bool, Stable>;
+        };
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Sorters
+
+    struct parallel_verge_sorter:
+        sorter_facade<detail::parallel_verge_sorter_impl<false>>
+    {};
+
+    template<>
+    struct stable_adapter<parallel_verge_sorter>:
+        sorter_facade<detail::parallel_verge_sorter_impl<true>>
+    {
+        stable_adapter() = default;
+
+        constexpr explicit stable_adapter(parallel_verge_sorter):
+            sorter_facade<detail::parallel_verge_sorter_impl<true>>()
+        {}
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Sort function
+
+    namespace
+    {
+        constexpr auto&& parallel_verge_sort
+            = utility::static_const<parallel_verge_sorter>::value;
+    }
+}
+
+#endif // CPPSORT_SORTERS_PARALLEL_VERGE_SORTER_H_
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_UTILITY_STRING_KEY_EXTRACTOR_H_
+#define CPPSORT_UTILITY_STRING_KEY_EXTRACTOR_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include "../detail/type_traits.h"
+
+#if __cplusplus > 201402L && __has_include(<string_view>)
+#   include <string_view>
+#endif
+
+namespace cppsort
+{
+namespace utility
+{
+    namespace detail
+    {
+        ////////////////////////////////////////////////////////////
+        // Map a character to an unsigned integer that compares
+        // like the original character
+
+        template<typename CharT>
+        constexpr auto ordered_char_key(CharT ch) noexcept
+            -> std::uintmax_t
+        {
+            using unsigned_type = std::make_unsigned_t<CharT>;
+            constexpr auto sign_bit = std::is_signed<CharT>::value ?
+                unsigned_type(1) << (std::numeric_limits<unsigned_type>::digits - 1) :
+                unsigned_type(0);
+            return static_cast<unsigned_type>(static_cast<unsigned_type>(ch) ^ sign_bit);
+        }
+
+        // Same as above but following the order of std::char_traits,
+        // which compares char as if it were unsigned char
+
+        template<typename CharT>
+        constexpr auto char_traits_key(CharT ch) noexcept
+            -> std::uintmax_t
+        {
+            return ordered_char_key(ch);
+        }
+
+        constexpr auto char_traits_key(char ch) noexcept
+            -> std::uintmax_t
+        {
+            return static_cast<unsigned char>(ch);
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Keys for the default lexicographical order of strings
+
+        template<typename String>
+        struct lexicographic_key_extractor
+        {
+            using key_type = std::uintmax_t;
+
+            lexicographic_key_extractor() = default;
+
+            template<typename Compare>
+            explicit constexpr lexicographic_key_extractor(const Compare&) noexcept {}
+
+            auto operator()(const String& str, std::size_t& pos) const
+                -> key_type
+            {
+                if (pos == str.size()) {
+                    return 0;
+                }
+                return char_traits_key(str[pos++]) + 1;
+            }
+        };
+
+        template<typename String>
+        struct reverse_lexicographic_key_extractor:
+            lexicographic_key_extractor<String>
+        {
+            using key_type = std::uintmax_t;
+
+            using lexicographic_key_extractor<String>::lexicographic_key_extractor;
+
+            auto operator()(const String& str, std::size_t& pos) const
+                -> key_type
+            {
+                return ~lexicographic_key_extractor<String>::operator()(str, pos);
+            }
+        };
+
+        ////////////////////////////////////////////////////////////
+        // Standard strings compared with the standard comparisons
+
+        template<typename String>
+        struct is_std_string:
+            std::false_type
+        {};
+
+        template<typename CharT, typename Allocator>
+        struct is_std_string<std::basic_string<CharT, std::char_traits<CharT>, Allocator>>:
+            std::true_type
+        {};
+
+#if __cplusplus > 201402L && __has_include(<string_view>)
+        template<typename CharT>
+        struct is_std_string<std::basic_string_view<CharT, std::char_traits<CharT>>>:
+            std::true_type
+        {};
+#endif
+
+        template<typename Compare, typename String, typename=void>
+        struct default_string_key_extractor {};
+
+        template<typename Compare, typename String>
+        struct default_string_key_extractor<
+            Compare, String,
+            cppsort::detail::enable_if_t<
+                is_std_string<String>::value && (
+                    std::is_same<Compare, std::less<>>::value ||
+                    std::is_same<Compare, std::less<String>>::value
+                )
+            >
+        >:
+            lexicographic_key_extractor<String>
+        {
+            using lexicographic_key_extractor<String>::lexicographic_key_extractor;
+        };
+
+        template<typename Compare, typename String>
+        struct default_string_key_extractor<
+            Compare, String,
+            cppsort::detail::enable_if_t<
+                is_std_string<String>::value && (
+                    std::is_same<Compare, std::greater<>>::value ||
+                    std::is_same<Compare, std::greater<String>>::value
+                )
+            >
+        >:
+            reverse_lexicographic_key_extractor<String>
+        {
+            using reverse_lexicographic_key_extractor<String>::reverse_lexicographic_key_extractor;
+        };
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Decomposes a string into a sequence of unsigned keys so
+    // that comparing two strings with Compare is equivalent to
+    // lexicographically comparing their sequences of keys
+    //
+    // Specializations must be constructible from an instance of
+    // Compare and provide the following members:
+    // - key_type: an unsigned integer type
+    // - operator()(const String& str, std::size_t& pos): returns
+    //   the key found at pos and moves pos past the characters
+    //   consumed to produce it; when pos is the end of the
+    //   string, it must leave pos unchanged and return a key
+    //   that compares different from any other key
+    //
+    // The primary template handles standard strings compared
+    // with std::less and std::greater, other specializations
+    // can be provided for other comparison functions
+
+    template<typename Compare, typename String>
+    struct string_key_extractor:
+        detail::default_string_key_extractor<Compare, String>
+    {
+        using detail::default_string_key_extractor<Compare, String>::default_string_key_extractor;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Whether a string can be decomposed into keys for a given
+    // comparison function
+
+    namespace detail
+    {
+        template<typename Compare, typename String>
+        using string_key_type_t = typename string_key_extractor<Compare, String>::key_type;
+    }
+
+    template<typename Compare, typename String>
+    struct has_string_key_extractor:
+        cppsort::detail::is_detected<
+            detail::string_key_type_t,
+            cppsort::detail::remove_cvref_t<Compare>,
+            cppsort::detail::remove_cvref_t<String>
+        >
+    {};
+
+    template<typename Compare, typename String>
+    constexpr bool has_string_key_extractor_v
+        = has_string_key_extractor<Compare, String>::value;
+}}
+
+#endif // CPPSORT_UTILITY_STRING_KEY_EXTRACTOR_H_
@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <functional>
 #include <iterator>
+#include <thread>
 #include <vector>
 #include <catch2/catch_test_macros.hpp>
 #include <cpp-sort/adapters/indirect_adapter.h>
@@ -104,3 +105,40 @@ TEST_CASE( "indirect_adapter over non-comparison sorter",
     sorter(collection, std::negate<>{});
     CHECK( std::is_sorted(collection.begin(), collection.end(), std::greater<>{}) );
 }
+
+namespace
+{
+    // Sorts a collection when the thread exits, after the per-thread
+    // scratch memory cache, constructed later, was destroyed
+    struct sort_on_thread_exit
+    {
+        std::vector<int> collection;
+        bool* sorted = nullptr;
+
+        ~sort_on_thread_exit()
+        {
+            cppsort::indirect_adapter<cppsort::quick_sorter> sorter;
+            sorter(collection);
+            *sorted = std::is_sorted(collection.begin(), collection.end());
+        }
+    };
+}
+
+TEST_CASE( "indirect_adapter in thread_local destructors",
+           "[indirect_adapter]" )
+{
+    bool sorted = false;
+    std::thread thread([&sorted] {
+        thread_local sort_on_thread_exit on_exit;
+        on_exit.sorted = &sorted;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(on_exit.collection), 221, -32);
+
+        // Populate the scratch memory cache of the thread
+        std::vector<int> collection = on_exit.collection;
+        cppsort::indirect_adapter<cppsort::quick_sorter> sorter;
+        sorter(collection);
+    });
+    thread.join();
+    CHECK( sorted );
+}
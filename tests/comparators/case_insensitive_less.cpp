@@ -3,6 +3,8 @@
  * SPDX-License-Identifier: MIT
  */
 #include <array>
+#include <cstddef>
+#include <deque>
 #include <locale>
 #include <string>
 #include <catch2/catch_test_macros.hpp>
@@ -95,3 +97,46 @@ TEST_CASE( "case-insensitive string comparison with case_insensitive_less", "[co
     }
 }
 
+
+TEST_CASE( "case_insensitive_less with long strings", "[comparison]" )
+{
+    // Contiguous strings of char take a vectorized path, the
+    // results are checked against non-contiguous sequences
+    auto check = [](const std::string& lhs, const std::string& rhs) {
+        std::deque<char> lhs_deque(lhs.begin(), lhs.end());
+        std::deque<char> rhs_deque(rhs.begin(), rhs.end());
+        auto expected = cppsort::case_insensitive_less(lhs_deque, rhs_deque);
+        CHECK( cppsort::case_insensitive_less(lhs, rhs) == expected );
+        CHECK( cppsort::case_insensitive_less(std::locale::classic())(lhs, rhs) == expected );
+        CHECK( cppsort::refined<std::string>(cppsort::case_insensitive_less)(lhs, rhs) == expected );
+    };
+
+    const std::string base = "The Quick Brown Fox Jumps Over The Lazy Dog [0123456789] {azAZ@`}";
+    std::string lower;
+    for (char ch: base) {
+        lower += (ch >= 'A' && ch <= 'Z') ? static_cast<char>(ch | 0x20) : ch;
+    }
+
+    check(base, lower);
+    check(lower, base);
+    check("", base);
+    check(base, "");
+    for (std::size_t pos = 0 ; pos < base.size() ; ++pos) {
+        // Mismatch at every position, including around
+        // characters close to the ASCII letters
+        std::string modified = lower;
+        modified[pos] = static_cast<char>(modified[pos] + 1);
+        check(base, modified);
+        check(modified, base);
+
+        // Prefixes of different sizes
+        check(base.substr(0, pos), lower);
+        check(lower, base.substr(0, pos));
+
+        // Non-ASCII bytes
+        std::string non_ascii = lower;
+        non_ascii[pos] = '\xC3';
+        check(base, non_ascii);
+        check(non_ascii, base);
+    }
+}
@@ -3,6 +3,8 @@
  * SPDX-License-Identifier: MIT
  */
 #include <array>
+#include <cstddef>
+#include <deque>
 #include <string>
 #include <catch2/catch_test_macros.hpp>
 #include <cpp-sort/comparators/natural_less.h>
@@ -33,3 +35,48 @@ TEST_CASE( "string natural sort with natural_less", "[comparison]" )
     CHECK( array == expected );
 }
 
+
+TEST_CASE( "natural_less with several numbers", "[comparison]" )
+{
+    // Numbers after the first one are also compared
+    // naturally, including numbers made of zeros
+    CHECK( cppsort::natural_less(std::string("a1b9"), std::string("a1b10")) );
+    CHECK_FALSE( cppsort::natural_less(std::string("a1b10"), std::string("a1b9")) );
+    CHECK( cppsort::natural_less(std::string("a00a"), std::string("a0b")) );
+    CHECK_FALSE( cppsort::natural_less(std::string("a0b"), std::string("a00a")) );
+    CHECK( cppsort::natural_less(std::string("v01.2"), std::string("v1.10")) );
+    CHECK_FALSE( cppsort::natural_less(std::string("v1.2"), std::string("v1.2")) );
+}
+
+TEST_CASE( "natural_less with long strings", "[comparison]" )
+{
+    // Contiguous strings of char take a vectorized path, the
+    // results are checked against non-contiguous sequences
+    auto check = [](const std::string& lhs, const std::string& rhs) {
+        std::deque<char> lhs_deque(lhs.begin(), lhs.end());
+        std::deque<char> rhs_deque(rhs.begin(), rhs.end());
+        CHECK( cppsort::natural_less(lhs, rhs) == cppsort::natural_less(lhs_deque, rhs_deque) );
+    };
+
+    const std::string base = "/usr/share/documentation/packages/library-name/chapter-/section-";
+    check(base, base);
+    check("", base);
+    check(base, "");
+    for (std::size_t pos = 0 ; pos < base.size() ; ++pos) {
+        // Mismatches and numbers at every position
+        std::string modified = base;
+        modified[pos] = static_cast<char>(modified[pos] + 1);
+        check(base, modified);
+        check(modified, base);
+
+        std::string number1 = base;
+        number1.insert(pos, "42");
+        std::string number2 = base;
+        number2.insert(pos, "0137");
+        check(number1, number2);
+        check(number2, number1);
+        check(number1, base);
+        check(base, number1);
+        check(base.substr(0, pos), base);
+    }
+}
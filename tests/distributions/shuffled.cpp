@@ -33,9 +33,26 @@ TEMPLATE_TEST_CASE( "test random-access sorters with shuffled distribution", "[d
                     >,
                     cppsort::heap_sorter,
                     cppsort::insertion_sorter,
+                    cppsort::lsd_radix_sorter<>,
                     cppsort::mel_sorter,
                     cppsort::merge_sorter,
                     cppsort::merge_insertion_sorter,
+                    cppsort::parallel_counting_sorter,
+                    cppsort::parallel_grail_sorter<>,
+                    cppsort::parallel_grail_sorter<
+                        cppsort::utility::dynamic_buffer<cppsort::utility::sqrt>
+                    >,
+                    cppsort::parallel_merge_sorter,
+                    cppsort::parallel_pdq_sorter,
+                    cppsort::parallel_ska_sorter,
+                    cppsort::parallel_spin_sorter,
+                    cppsort::parallel_tim_sorter,
+                    cppsort::parallel_verge_sorter,
+                    cppsort::parallel_wiki_sorter<>,
+                    cppsort::parallel_wiki_sorter<
+                        cppsort::utility::fixed_buffer<0>
+                    >,
+                    cppsort::parallel_spread_sorter,
                     cppsort::pdq_sorter,
                     cppsort::poplar_sorter,
                     cppsort::quick_merge_sorter,
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/probes/approx/inv.h>
+#include <cpp-sort/probes/approx/mono.h>
+#include <cpp-sort/probes/approx/rem.h>
+#include <cpp-sort/probes/approx/runs.h>
+#include <cpp-sort/probes/inv.h>
+#include <cpp-sort/probes/mono.h>
+#include <cpp-sort/probes/rem.h>
+#include <cpp-sort/probes/runs.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/internal_compare.h>
+
+TEST_CASE( "approximate presortedness measures", "[probe][approx]" )
+{
+    namespace approx = cppsort::probe::approx;
+
+    SECTION( "small collections are measured exactly" )
+    {
+        const std::vector<int> vec = { 48, 43, 96, 44, 42, 34, 42, 57, 68, 69 };
+
+        auto inv = approx::inv(vec);
+        CHECK( inv.value == cppsort::probe::inv(vec) );
+        CHECK( inv.error == 0 );
+
+        auto mono = approx::mono(vec, std::negate<>{});
+        CHECK( mono.value == cppsort::probe::mono(vec, std::negate<>{}) );
+        CHECK( mono.error == 0 );
+
+        auto rem = approx::rem(vec.begin(), vec.end());
+        CHECK( rem.value == cppsort::probe::rem(vec) );
+        CHECK( rem.error == 0 );
+
+        auto runs = approx::runs(vec, std::greater<>{});
+        CHECK( runs.value == cppsort::probe::runs(vec, std::greater<>{}) );
+        CHECK( runs.error == 0 );
+
+        std::vector<internal_compare<int>> tricky(vec.begin(), vec.end());
+        CHECK( approx::inv(tricky, &internal_compare<int>::compare_to).value == 19 );
+    }
+
+    SECTION( "sorted and reverse-sorted collections" )
+    {
+        std::vector<int> vec;
+        auto distribution = dist::ascending{};
+        distribution(std::back_inserter(vec), 100'000);
+        auto size = static_cast<std::ptrdiff_t>(vec.size());
+
+        CHECK( approx::inv(vec).value == 0 );
+        CHECK( approx::rem(vec).value == 0 );
+        CHECK( approx::runs(vec).value == 0 );
+
+        CHECK( approx::inv(vec, std::greater<>{}).value == approx::inv.max_for_size(size) );
+        CHECK( approx::runs(vec, std::greater<>{}).value == approx::runs.max_for_size(size) );
+        CHECK( approx::rem(vec, std::greater<>{}).value <= approx::rem.max_for_size(size) );
+
+        // Mono is only known up to the number of blocks
+        auto mono = approx::mono(vec);
+        CHECK( mono.value - mono.error <= 0 );
+        CHECK( mono.value <= approx::mono.max_for_size(size) );
+    }
+
+    SECTION( "estimates are close to the actual measures" )
+    {
+        std::vector<int> vec;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(vec), 100'000);
+
+        // The errors are 95% confidence bounds, checking against
+        // twice the errors should never fail in practice
+        auto inv = approx::inv_t(4096)(vec);
+        CHECK( inv.error > 0 );
+        CHECK( inv.value - 2 * inv.error <= cppsort::probe::inv(vec) );
+        CHECK( cppsort::probe::inv(vec) <= inv.value + 2 * inv.error );
+
+        auto runs = approx::runs_t(4096)(vec, std::negate<>{});
+        CHECK( runs.error > 0 );
+        CHECK( runs.value - 2 * runs.error <= cppsort::probe::runs(vec, std::negate<>{}) );
+        CHECK( cppsort::probe::runs(vec, std::negate<>{}) <= runs.value + 2 * runs.error );
+
+        auto mono = approx::mono_t(4096)(vec);
+        CHECK( mono.error > 0 );
+        CHECK( mono.value - 2 * mono.error <= cppsort::probe::mono(vec) );
+        CHECK( cppsort::probe::mono(vec) <= mono.value + 2 * mono.error );
+
+        // Rem only has a lower bound
+        auto rem = approx::rem_t(4096)(vec);
+        CHECK( rem.error > 0 );
+        CHECK( rem.value - rem.error <= cppsort::probe::rem(vec) );
+    }
+}
@@ -2,11 +2,16 @@
  * Copyright (c) 2016-2022 Morwenn
  * SPDX-License-Identifier: MIT
  */
+#include <cstddef>
 #include <forward_list>
+#include <functional>
+#include <iterator>
+#include <list>
 #include <vector>
 #include <catch2/catch_test_macros.hpp>
 #include <cpp-sort/probes/inv.h>
 #include <cpp-sort/utility/size.h>
+#include <testing-tools/distributions.h>
 #include <testing-tools/internal_compare.h>
 
 TEST_CASE( "presortedness measure: inv", "[probe][inv]" )
@@ -35,3 +40,24 @@ TEST_CASE( "presortedness measure: inv", "[probe][inv]" )
         CHECK( inv(li.begin(), li.end()) == max_n );
     }
 }
+
+TEST_CASE( "presortedness measure: inv with arithmetic values", "[probe][inv]" )
+{
+    // Random-access collections of arithmetic values are handled
+    // with a dedicated algorithm, check it against the generic one
+    using cppsort::probe::inv;
+
+    std::vector<int> collection;
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 100'000, -5'000);
+    // Add a few duplicates
+    for (std::size_t idx = 0 ; idx < collection.size() ; idx += 7) {
+        collection[idx] = collection[idx / 2];
+    }
+    std::list<int> li(collection.begin(), collection.end());
+
+    CHECK( inv(collection) == inv(li) );
+    CHECK( inv(collection, std::greater<>{}) == inv(li, std::greater<>{}) );
+    CHECK( inv(collection, std::negate<>{}) == inv(li, std::negate<>{}) );
+    CHECK( inv(collection.begin(), collection.begin() + 20) == inv(li.begin(), std::next(li.begin(), 20)) );
+}
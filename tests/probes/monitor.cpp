@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/probes/dis.h>
+#include <cpp-sort/probes/inv.h>
+#include <cpp-sort/probes/mono.h>
+#include <cpp-sort/probes/monitor.h>
+#include <cpp-sort/probes/runs.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/internal_compare.h>
+
+TEST_CASE( "online presortedness monitor", "[probe][monitor]" )
+{
+    using namespace cppsort;
+
+    SECTION( "same results as the probes on every prefix" )
+    {
+        std::vector<int> collection;
+        auto distribution = dist::shuffled_16_values{};
+        distribution(std::back_inserter(collection), 300);
+
+        probe::monitor<int, std::greater<>> monitor(std::greater<>{});
+        std::vector<int> prefix;
+        for (int value: collection) {
+            monitor.push(value);
+            prefix.push_back(value);
+            CHECK( monitor.size() == static_cast<std::ptrdiff_t>(prefix.size()) );
+            CHECK( monitor.runs() == probe::runs(prefix, std::greater<>{}) );
+            CHECK( monitor.mono() == probe::mono(prefix, std::greater<>{}) );
+            CHECK( monitor.dis() == probe::dis(prefix, std::greater<>{}) );
+            // The sample holds every element below the budget
+            CHECK( monitor.inv().value == probe::inv(prefix, std::greater<>{}) );
+            CHECK( monitor.inv().error == 0 );
+        }
+    }
+
+    SECTION( "elements equivalent to the maximum" )
+    {
+        const std::vector<int> values = { 3, 7, 7, 1, 7, 7, 2, 7, 0, 8, 8, 5 };
+        probe::monitor<int> monitor;
+        std::vector<int> prefix;
+        for (int value: values) {
+            monitor.push(value);
+            prefix.push_back(value);
+            CHECK( monitor.dis() == probe::dis(prefix) );
+        }
+    }
+
+    SECTION( "comparison and projection" )
+    {
+        const std::vector<int> values = { 48, 43, 96, 44, 42, 34, 42, 57, 68, 69 };
+
+        probe::monitor<int, std::less<>, std::negate<>> monitor(std::less<>{}, std::negate<>{});
+        using compare_type = decltype(&internal_compare<int>::compare_to);
+        probe::monitor<internal_compare<int>, compare_type> tricky(&internal_compare<int>::compare_to);
+        for (int value: values) {
+            monitor.push(value);
+            tricky.push(internal_compare<int>(value));
+        }
+
+        CHECK( monitor.runs() == probe::runs(values, std::greater<>{}) );
+        CHECK( monitor.mono() == probe::mono(values, std::greater<>{}) );
+        CHECK( monitor.dis() == probe::dis(values, std::greater<>{}) );
+        CHECK( monitor.inv().value == probe::inv(values, std::greater<>{}) );
+
+        CHECK( tricky.runs() == probe::runs(values) );
+        CHECK( tricky.mono() == probe::mono(values) );
+        CHECK( tricky.dis() == probe::dis(values) );
+        CHECK( tricky.inv().value == probe::inv(values) );
+    }
+
+    SECTION( "estimate of Inv past the sample budget" )
+    {
+        std::vector<int> collection;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), 10'000);
+
+        probe::monitor<int> monitor(std::size_t(256));
+        for (int value: collection) {
+            monitor.push(value);
+        }
+        CHECK( monitor.runs() == probe::runs(collection) );
+        CHECK( monitor.mono() == probe::mono(collection) );
+        CHECK( monitor.dis() == probe::dis(collection) );
+
+        auto inv = monitor.inv();
+        CHECK( inv.error > 0 );
+        CHECK( inv.value - inv.error <= probe::inv(collection) );
+        CHECK( probe::inv(collection) <= inv.value + inv.error );
+
+        monitor.clear();
+        CHECK( monitor.size() == 0 );
+        CHECK( monitor.runs() == 0 );
+        CHECK( monitor.dis() == 0 );
+        CHECK( monitor.inv().value == 0 );
+    }
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <forward_list>
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/probes.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/internal_compare.h>
+
+TEST_CASE( "presortedness measures: multi", "[probe][multi]" )
+{
+    using namespace cppsort;
+    using probe_multi = probe::multi<
+        decltype(probe::runs),
+        decltype(probe::mono),
+        decltype(probe::ham),
+        decltype(probe::exc),
+        decltype(probe::max),
+        decltype(probe::block),
+        decltype(probe::dis),
+        decltype(probe::inv)
+    >;
+    probe_multi multi;
+
+    SECTION( "same results as the individual probes" )
+    {
+        std::vector<int> collection;
+        auto distribution = dist::shuffled_16_values{};
+        distribution(std::back_inserter(collection), 491);
+        // Add a few sorted and reverse-sorted runs
+        for (int idx = 0 ; idx < 491 ; ++idx) {
+            collection.push_back(idx % 50 < 25 ? idx : -idx);
+        }
+        const std::forward_list<int> li(collection.begin(), collection.end());
+
+        auto res = multi(collection);
+        CHECK( std::get<0>(res) == probe::runs(collection) );
+        CHECK( std::get<1>(res) == probe::mono(collection) );
+        CHECK( std::get<2>(res) == probe::ham(collection) );
+        CHECK( std::get<3>(res) == probe::exc(collection) );
+        CHECK( std::get<4>(res) == probe::max(collection) );
+        CHECK( std::get<5>(res) == probe::block(collection) );
+        CHECK( std::get<6>(res) == probe::dis(collection) );
+        CHECK( std::get<7>(res) == probe::inv(collection) );
+
+        auto res_li = multi(li.begin(), li.end(), std::greater<>{});
+        CHECK( std::get<0>(res_li) == probe::runs(li, std::greater<>{}) );
+        CHECK( std::get<1>(res_li) == probe::mono(li, std::greater<>{}) );
+        CHECK( std::get<2>(res_li) == probe::ham(li, std::greater<>{}) );
+        CHECK( std::get<3>(res_li) == probe::exc(li, std::greater<>{}) );
+        CHECK( std::get<4>(res_li) == probe::max(li, std::greater<>{}) );
+        CHECK( std::get<5>(res_li) == probe::block(li, std::greater<>{}) );
+        CHECK( std::get<6>(res_li) == probe::dis(li, std::greater<>{}) );
+        CHECK( std::get<7>(res_li) == probe::inv(li, std::greater<>{}) );
+    }
+
+    SECTION( "projections" )
+    {
+        const std::vector<int> values = { 48, 43, 96, 44, 42, 34, 42, 57, 68, 69 };
+        std::vector<internal_compare<int>> tricky(values.begin(), values.end());
+        auto res = probe::multi<decltype(probe::runs), decltype(probe::ham)>{}(
+            tricky, &internal_compare<int>::compare_to
+        );
+        CHECK( std::get<0>(res) == probe::runs(values) );
+        CHECK( std::get<1>(res) == probe::ham(values) );
+    }
+
+    SECTION( "small collections" )
+    {
+        std::vector<int> empty;
+        CHECK( multi(empty) == std::make_tuple(0, 0, 0, 0, 0, 0, 0, 0) );
+        std::vector<int> one = { 5 };
+        CHECK( multi(one) == std::make_tuple(0, 0, 0, 0, 0, 0, 0, 0) );
+    }
+}
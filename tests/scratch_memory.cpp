@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <memory>
+#include <thread>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/detail/immovable_vector.h>
+
+namespace
+{
+    // Releases its buffer when the thread exits, after the per-thread
+    // scratch memory cache, constructed later, was destroyed
+    struct release_on_thread_exit
+    {
+        std::unique_ptr<cppsort::detail::immovable_vector<int>> buffer;
+    };
+}
+
+TEST_CASE( "scratch memory released in thread_local destructors",
+           "[scratch_memory]" )
+{
+    // The buffer is allocated through the cache and released after its
+    // destruction, which must use the same size as the allocation:
+    // sanitizers check the sized deallocation
+    int sum = 0;
+    std::thread thread([&sum] {
+        thread_local release_on_thread_exit on_exit;
+        on_exit.buffer = std::make_unique<cppsort::detail::immovable_vector<int>>(3);
+        for (int i = 0 ; i < 3 ; ++i) {
+            on_exit.buffer->emplace_back(i);
+        }
+        for (auto value: *on_exit.buffer) {
+            sum += value;
+        }
+    });
+    thread.join();
+    CHECK( sum == 3 );
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/sorters/auto_sorter.h>
+#include <testing-tools/distributions.h>
+
+TEST_CASE( "auto_sorter tests", "[auto_sorter]" )
+{
+    // Size of the collections to sort
+    auto size = 100'000;
+
+    SECTION( "sort with every kind of presortedness" )
+    {
+        std::vector<int> vec; vec.reserve(size);
+        auto check = [&](auto distribution) {
+            vec.clear();
+            distribution(std::back_inserter(vec), size);
+            cppsort::auto_sort(vec);
+            CHECK( std::is_sorted(vec.begin(), vec.end()) );
+        };
+        check(dist::shuffled{});
+        check(dist::shuffled_16_values{});
+        check(dist::all_equal{});
+        check(dist::ascending{});
+        check(dist::descending{});
+        check(dist::pipe_organ{});
+        check(dist::push_front{});
+        check(dist::ascending_sawtooth{});
+        check(dist::descending_sawtooth{});
+        check(dist::inversions(0.01));
+    }
+
+    SECTION( "sort with comparison and projection" )
+    {
+        std::vector<double> vec; vec.reserve(size);
+        auto distribution = dist::ascending_sawtooth{};
+        distribution(std::back_inserter(vec), size);
+        cppsort::auto_sort(vec, std::greater<>{}, std::negate<>{});
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+
+        std::vector<std::string> strings;
+        for (auto value: vec) {
+            strings.push_back(std::to_string(value));
+        }
+        cppsort::auto_sort(strings, std::greater<>{});
+        CHECK( std::is_sorted(strings.begin(), strings.end(), std::greater<>{}) );
+    }
+
+    SECTION( "sort with bidirectional iterators" )
+    {
+        std::list<int> li;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(li), size);
+        cppsort::auto_sort(li);
+        CHECK( std::is_sorted(li.begin(), li.end()) );
+    }
+
+    SECTION( "thresholds picking every algorithm" )
+    {
+        std::vector<long long int> collection; collection.reserve(size);
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), size, -1568);
+
+        auto check = [&](const cppsort::auto_sorter_thresholds& thresholds) {
+            auto vec = collection;
+            cppsort::auto_sorter sorter(thresholds);
+            sorter(vec);
+            CHECK( std::is_sorted(vec.begin(), vec.end()) );
+            vec = collection;
+            sorter(vec, std::greater<>{});
+            CHECK( std::is_sorted(vec.begin(), vec.end(), std::greater<>{}) );
+        };
+
+        cppsort::auto_sorter_thresholds thresholds;
+        thresholds.small_size = 0;
+
+        // counting_sorter
+        thresholds.counting_range_factor = 1e9;
+        check(thresholds);
+        thresholds.counting_range_factor = 0.0;
+        // tim_sorter
+        thresholds.tim_max_runs = 1.0;
+        check(thresholds);
+        thresholds.tim_max_runs = -1.0;
+        // drop_merge_sorter
+        thresholds.drop_merge_max_rem = 1.0;
+        check(thresholds);
+        thresholds.drop_merge_max_rem = -1.0;
+        // verge_sorter
+        thresholds.verge_max_mono = 1.0;
+        check(thresholds);
+        thresholds.verge_max_mono = -1.0;
+        // ska_sorter and pdq_sorter
+        check(thresholds);
+    }
+}
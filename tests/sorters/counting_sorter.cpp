@@ -6,6 +6,7 @@
 #include <forward_list>
 #include <functional>
 #include <iterator>
+#include <limits>
 #include <list>
 #include <vector>
 #include <catch2/catch_test_macros.hpp>
@@ -69,6 +70,67 @@ TEST_CASE( "counting_sorter tests", "[counting_sorter]" )
     }
 #endif
 
+    SECTION( "sort with sparse values" )
+    {
+        // A few outliers make the range of values much wider
+        // than the collection
+        std::vector<long long> vec; vec.reserve(size);
+        distribution(std::back_inserter(vec), size, -1568);
+        vec[42] = 1'000'000'000'000;
+        vec[1337] = -1'000'000'000'000;
+        cppsort::counting_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+        CHECK( vec.front() == -1'000'000'000'000 );
+        CHECK( vec.back() == 1'000'000'000'000 );
+    }
+
+    SECTION( "reverse sort with sparse values iterators" )
+    {
+        std::forward_list<int> li;
+        distribution(std::front_inserter(li), size, 0);
+        li.push_front((std::numeric_limits<int>::max)());
+        li.push_front((std::numeric_limits<int>::min)());
+        cppsort::counting_sort(li.begin(), li.end(), std::greater<>{});
+        CHECK( std::is_sorted(li.begin(), li.end(), std::greater<>{}) );
+        CHECK( li.front() == (std::numeric_limits<int>::max)() );
+    }
+
+    SECTION( "sort with negative char values" )
+    {
+        // The sparse path used to order negative plain char values
+        // as unsigned char
+        std::vector<int> values; values.reserve(1000);
+        for (int i = 0 ; i < 1000 ; ++i) {
+            values.push_back((i * 37) % 201 - 100);
+        }
+
+        std::vector<char> vec(values.begin(), values.end());
+        cppsort::counting_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+        cppsort::counting_sort(vec, std::greater<>{});
+        CHECK( std::is_sorted(vec.begin(), vec.end(), std::greater<>{}) );
+
+        std::vector<signed char> svec(values.begin(), values.end());
+        cppsort::counting_sort(svec);
+        CHECK( std::is_sorted(svec.begin(), svec.end()) );
+        cppsort::counting_sort(svec, std::greater<>{});
+        CHECK( std::is_sorted(svec.begin(), svec.end(), std::greater<>{}) );
+    }
+
+    SECTION( "sort with sparse negative wchar_t values" )
+    {
+        std::vector<int> values; values.reserve(1000);
+        for (int i = 0 ; i < 1000 ; ++i) {
+            values.push_back(((i * 37) % 201 - 100) * 100'000);
+        }
+
+        std::vector<wchar_t> vec(values.begin(), values.end());
+        cppsort::counting_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+        cppsort::counting_sort(vec, std::greater<>{});
+        CHECK( std::is_sorted(vec.begin(), vec.end(), std::greater<>{}) );
+    }
+
     SECTION( "GitHub issue #103" )
     {
         // Specific bug in counting_sort due to another specific bug in
@@ -34,6 +34,15 @@ TEST_CASE( "test every instantiated sorter", "[sorters]" )
         CHECK( std::is_sorted(collection.begin(), collection.end()) );
     }
 
+    SECTION( "auto_sort" )
+    {
+        cppsort::auto_sort(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+
+        cppsort::auto_sort(li);
+        CHECK( std::is_sorted(li.begin(), li.end()) );
+    }
+
     SECTION( "cartesian_tree_sort" )
     {
         cppsort::cartesian_tree_sort(collection);
@@ -76,6 +85,12 @@ TEST_CASE( "test every instantiated sorter", "[sorters]" )
         CHECK( std::is_sorted(collection.begin(), collection.end()) );
     }
 
+    SECTION( "lsd_radix_sorter" )
+    {
+        cppsort::lsd_radix_sort(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+
     SECTION( "mel_sorter" )
     {
         cppsort::mel_sort(collection);
@@ -94,6 +109,60 @@ TEST_CASE( "test every instantiated sorter", "[sorters]" )
         CHECK( std::is_sorted(collection.begin(), collection.end()) );
     }
 
+    SECTION( "parallel_counting_sorter" )
+    {
+        cppsort::parallel_counting_sort(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+
+    SECTION( "parallel_grail_sorter" )
+    {
+        cppsort::parallel_grail_sort(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+
+    SECTION( "parallel_pdq_sorter" )
+    {
+        cppsort::parallel_pdq_sort(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+
+    SECTION( "parallel_ska_sorter" )
+    {
+        cppsort::parallel_ska_sort(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+
+    SECTION( "parallel_spin_sorter" )
+    {
+        cppsort::parallel_spin_sort(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+
+    SECTION( "parallel_spread_sorter" )
+    {
+        cppsort::parallel_spread_sort(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+
+    SECTION( "parallel_tim_sorter" )
+    {
+        cppsort::parallel_tim_sort(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+
+    SECTION( "parallel_verge_sorter" )
+    {
+        cppsort::parallel_verge_sort(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+
+    SECTION( "parallel_wiki_sorter" )
+    {
+        cppsort::parallel_wiki_sort(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+
     SECTION( "pdq_sorter" )
     {
         cppsort::pdq_sort(collection);
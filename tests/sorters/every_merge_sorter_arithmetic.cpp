@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/adapters/stable_adapter.h>
+#include <cpp-sort/sorters.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/wrapper.h>
+
+namespace
+{
+    template<typename Sorter, typename T, typename Distribution, typename... Args>
+    auto merge_sort_arithmetic(Distribution distribution, Args... args)
+        -> bool
+    {
+        std::vector<T> collection;
+        distribution.template call<T>(std::back_inserter(collection), 10'000);
+        auto expected = collection;
+        std::stable_sort(expected.begin(), expected.end(), args...);
+
+        // Iterators and pointers can take different paths
+        auto vec = collection;
+        Sorter{}(vec.begin(), vec.end(), args...);
+        auto ptr = collection;
+        Sorter{}(ptr.data(), ptr.data() + ptr.size(), args...);
+        return vec == expected && ptr == expected;
+    }
+
+    template<typename Sorter, typename T, typename Distribution>
+    auto merge_sort_arithmetic_both_orders(Distribution distribution)
+        -> bool
+    {
+        return merge_sort_arithmetic<Sorter, T>(distribution)
+            && merge_sort_arithmetic<Sorter, T>(distribution, std::greater<>{});
+    }
+}
+
+TEMPLATE_TEST_CASE( "merge-based sorters with arithmetic types", "[sorters][merge]",
+                    cppsort::adaptive_shivers_sorter,
+                    cppsort::mel_sorter,
+                    cppsort::merge_sorter,
+                    cppsort::spin_sorter,
+                    cppsort::stable_t<cppsort::verge_sorter>,
+                    cppsort::tim_sorter,
+                    cppsort::wiki_sorter<> )
+{
+    // The merge steps of these sorters use a dedicated merge
+    // kernel for such types, which may rely on SIMD instructions
+    // when the target instruction set allows it
+
+    SECTION( "shuffled_16_values" )
+    {
+        auto distribution = dist::shuffled_16_values{};
+        CHECK( merge_sort_arithmetic_both_orders<TestType, std::int32_t>(distribution) );
+        CHECK( merge_sort_arithmetic_both_orders<TestType, std::uint32_t>(distribution) );
+        CHECK( merge_sort_arithmetic_both_orders<TestType, std::int64_t>(distribution) );
+        CHECK( merge_sort_arithmetic_both_orders<TestType, std::uint64_t>(distribution) );
+        CHECK( merge_sort_arithmetic_both_orders<TestType, float>(distribution) );
+        CHECK( merge_sort_arithmetic_both_orders<TestType, double>(distribution) );
+    }
+
+    SECTION( "ascending_sawtooth" )
+    {
+        auto distribution = dist::ascending_sawtooth{};
+        CHECK( merge_sort_arithmetic_both_orders<TestType, std::int32_t>(distribution) );
+        CHECK( merge_sort_arithmetic_both_orders<TestType, std::uint64_t>(distribution) );
+        CHECK( merge_sort_arithmetic_both_orders<TestType, double>(distribution) );
+    }
+
+    SECTION( "inversions" )
+    {
+        // Long runs already in place exercise the galloping steps
+        auto distribution = dist::inversions(0.05);
+        CHECK( merge_sort_arithmetic_both_orders<TestType, std::int32_t>(distribution) );
+        CHECK( merge_sort_arithmetic_both_orders<TestType, std::int64_t>(distribution) );
+        CHECK( merge_sort_arithmetic_both_orders<TestType, float>(distribution) );
+    }
+}
+
+TEST_CASE( "merge kernel stability with signed zeros", "[sorters][merge][is_stable]" )
+{
+    // -0.0 and 0.0 are equivalent but distinguishable, the merge
+    // kernel must keep them in their original order
+
+    std::vector<long long int> values;
+    auto distribution = dist::shuffled_16_values{};
+    distribution(std::back_inserter(values), 10'000);
+    std::vector<double> collection;
+    for (long long int value: values) {
+        collection.push_back(value == 0 ? 0.0 : value == 1 ? -0.0 : static_cast<double>(value));
+    }
+    auto expected = collection;
+    std::stable_sort(expected.begin(), expected.end());
+
+    auto same_bits = [&](const std::vector<double>& vec) {
+        return std::memcmp(vec.data(), expected.data(), vec.size() * sizeof(double)) == 0;
+    };
+
+    auto vec = collection;
+    cppsort::tim_sort(vec);
+    CHECK( same_bits(vec) );
+    vec = collection;
+    cppsort::merge_sort(vec);
+    CHECK( same_bits(vec) );
+    vec = collection;
+    cppsort::spin_sort(vec);
+    CHECK( same_bits(vec) );
+}
+
+TEMPLATE_TEST_CASE( "merge-based sorters with trivially copyable types", "[sorters][merge][is_stable]",
+                    cppsort::adaptive_shivers_sorter,
+                    cppsort::merge_sorter,
+                    cppsort::spin_sorter,
+                    cppsort::stable_t<cppsort::verge_sorter>,
+                    cppsort::tim_sorter,
+                    cppsort::wiki_sorter<> )
+{
+    // The scalar merge kernel handles any trivially copyable type,
+    // with a projection, and must preserve the order of equivalent
+    // elements
+
+    using wrapper = generic_stable_wrapper<int>;
+    static_assert(std::is_trivially_copyable<wrapper>::value, "");
+
+    std::vector<wrapper> collection;
+    auto distribution = dist::shuffled_16_values{};
+    distribution(std::back_inserter(collection), 10'000);
+    for (std::size_t idx = 0 ; idx < collection.size() ; ++idx) {
+        collection[idx].order = static_cast<int>(idx);
+    }
+
+    auto expected = collection;
+    std::stable_sort(expected.begin(), expected.end(), [](const wrapper& lhs, const wrapper& rhs) {
+        return lhs.value < rhs.value;
+    });
+    auto vec = collection;
+    TestType{}(vec, &wrapper::value);
+    CHECK( vec == expected );
+
+    std::stable_sort(expected.begin(), expected.end(), [](const wrapper& lhs, const wrapper& rhs) {
+        return lhs.value > rhs.value;
+    });
+    vec = collection;
+    TestType{}(vec.data(), vec.data() + vec.size(), std::greater<>{}, &wrapper::value);
+    CHECK( vec == expected );
+}
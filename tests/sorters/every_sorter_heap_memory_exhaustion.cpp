@@ -24,6 +24,7 @@ TEMPLATE_TEST_CASE( "heap exhaustion for random-access sorters", "[sorters][heap
                     cppsort::grail_sorter<>,
                     cppsort::heap_sorter,
                     cppsort::insertion_sorter,
+                    cppsort::lsd_radix_sorter<>,
                     cppsort::merge_sorter,
                     cppsort::pdq_sorter,
                     cppsort::quick_merge_sorter,
@@ -39,6 +39,7 @@ namespace
 
 TEMPLATE_TEST_CASE( "test every sorter with long std::string", "[sorters]",
                     cppsort::adaptive_shivers_sorter,
+                    cppsort::auto_sorter,
                     cppsort::cartesian_tree_sorter,
                     cppsort::d_ary_heap_sorter<6>,
                     cppsort::default_sorter,
@@ -52,6 +53,14 @@ TEMPLATE_TEST_CASE( "test every sorter with long std::string", "[sorters]",
                     cppsort::mel_sorter,
                     cppsort::merge_insertion_sorter,
                     cppsort::merge_sorter,
+                    cppsort::parallel_grail_sorter<>,
+                    cppsort::parallel_merge_sorter,
+                    cppsort::parallel_pdq_sorter,
+                    cppsort::parallel_ska_sorter,
+                    cppsort::parallel_spin_sorter,
+                    cppsort::parallel_tim_sorter,
+                    cppsort::parallel_verge_sorter,
+                    cppsort::parallel_wiki_sorter<>,
                     cppsort::pdq_sorter,
                     cppsort::poplar_sorter,
                     cppsort::quick_merge_sorter,
@@ -15,6 +15,7 @@
 
 TEMPLATE_TEST_CASE( "test most sorters with no_post_iterator", "[sorters]",
                     cppsort::adaptive_shivers_sorter,
+                    cppsort::auto_sorter,
                     cppsort::cartesian_tree_sorter,
                     cppsort::counting_sorter,
                     cppsort::d_ary_heap_sorter<6>,
@@ -23,9 +24,20 @@ TEMPLATE_TEST_CASE( "test most sorters with no_post_iterator", "[sorters]",
                     cppsort::grail_sorter<>,
                     cppsort::heap_sorter,
                     cppsort::insertion_sorter,
+                    cppsort::lsd_radix_sorter<>,
                     cppsort::mel_sorter,
                     cppsort::merge_insertion_sorter,
                     cppsort::merge_sorter,
+                    cppsort::parallel_counting_sorter,
+                    cppsort::parallel_grail_sorter<>,
+                    cppsort::parallel_merge_sorter,
+                    cppsort::parallel_pdq_sorter,
+                    cppsort::parallel_ska_sorter,
+                    cppsort::parallel_spin_sorter,
+                    cppsort::parallel_spread_sorter,
+                    cppsort::parallel_tim_sorter,
+                    cppsort::parallel_verge_sorter,
+                    cppsort::parallel_wiki_sorter<cppsort::utility::fixed_buffer<0>>,
                     cppsort::pdq_sorter,
                     cppsort::poplar_sorter,
                     cppsort::quick_merge_sorter,
@@ -56,6 +68,8 @@ TEMPLATE_TEST_CASE( "test most sorters with no_post_iterator", "[sorters]",
 
 TEMPLATE_TEST_CASE( "test type-specific sorters with no_post_iterator further",
                     "[sorters][ska_sorter][spread_sorter]",
+                    cppsort::parallel_ska_sorter,
+                    cppsort::parallel_spread_sorter,
                     cppsort::ska_sorter,
                     cppsort::spread_sorter )
 {
@@ -78,6 +78,7 @@ namespace
 
 TEMPLATE_TEST_CASE( "random-access sorters against throwing move operations", "[sorters][throwing_moves]",
                     cppsort::adaptive_shivers_sorter,
+                    cppsort::auto_sorter,
                     cppsort::cartesian_tree_sorter,
                     cppsort::d_ary_heap_sorter<3>,
                     cppsort::drop_merge_sorter,
@@ -90,6 +91,13 @@ TEMPLATE_TEST_CASE( "random-access sorters against throwing move operations", "[
                     cppsort::mel_sorter,
                     cppsort::merge_insertion_sorter,
                     cppsort::merge_sorter,
+                    cppsort::parallel_grail_sorter<>,
+                    cppsort::parallel_merge_sorter,
+                    cppsort::parallel_pdq_sorter,
+                    cppsort::parallel_spin_sorter,
+                    cppsort::parallel_tim_sorter,
+                    cppsort::parallel_verge_sorter,
+                    cppsort::parallel_wiki_sorter<>,
                     cppsort::pdq_sorter,
                     cppsort::poplar_sorter,
                     cppsort::quick_merge_sorter,
@@ -147,6 +155,7 @@ TEMPLATE_TEST_CASE( "random-access sorters against throwing move operations", "[
 }
 
 TEMPLATE_TEST_CASE( "bidirectional sorters against throwing move operations", "[sorters][throwing_moves]",
+                    cppsort::auto_sorter,
                     cppsort::cartesian_tree_sorter,
                     cppsort::drop_merge_sorter,
                     cppsort::insertion_sorter,
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <random>
+#include <utility>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/sorters/lsd_radix_sorter.h>
+#include <cpp-sort/utility/buffer.h>
+#include <cpp-sort/utility/functional.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/random.h>
+
+TEST_CASE( "lsd_radix_sorter tests", "[lsd_radix_sorter]" )
+{
+    auto distribution = dist::shuffled{};
+
+    SECTION( "sort with int iterable" )
+    {
+        std::vector<int> vec;
+        distribution(std::back_inserter(vec), 100'000, -50'000);
+        cppsort::lsd_radix_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "sort with 40-bit integers" )
+    {
+        std::vector<std::uint64_t> vec;
+        std::uniform_int_distribution<std::uint64_t> dist(0, (std::uint64_t(1) << 40) - 1);
+        auto&& engine = hasard::engine();
+        for (int i = 0 ; i < 100'000 ; ++i) {
+            vec.push_back(dist(engine));
+        }
+        auto expected = vec;
+        std::sort(expected.begin(), expected.end());
+        cppsort::lsd_radix_sort(vec);
+        CHECK( vec == expected );
+    }
+
+    SECTION( "sort with random 64-bit integers" )
+    {
+        // Too many passes, falls back to ska_sort
+        std::vector<std::uint64_t> vec;
+        std::uniform_int_distribution<std::uint64_t> dist;
+        auto&& engine = hasard::engine();
+        for (int i = 0 ; i < 100'000 ; ++i) {
+            vec.push_back(dist(engine));
+        }
+        auto expected = vec;
+        std::sort(expected.begin(), expected.end());
+        cppsort::lsd_radix_sort(vec.begin(), vec.end());
+        CHECK( vec == expected );
+    }
+
+#ifdef __SIZEOF_INT128__
+    SECTION( "sort with int128 iterable" )
+    {
+        std::vector<__int128_t> vec;
+        distribution(std::back_inserter(vec), 100'000, -10'000);
+        cppsort::lsd_radix_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+#endif
+
+    SECTION( "sort with float iterable" )
+    {
+        std::vector<float> vec;
+        distribution.call<float>(std::back_inserter(vec), 100'000, -50'000);
+        cppsort::lsd_radix_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "sort with double iterators" )
+    {
+        std::vector<double> vec;
+        distribution.call<double>(std::back_inserter(vec), 100'000, -50'000);
+        cppsort::lsd_radix_sort(vec.begin(), vec.end());
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "sort with deque and projection" )
+    {
+        std::deque<std::pair<int, int>> collection;
+        for (int i = 0 ; i < 10'000 ; ++i) {
+            collection.emplace_back(i % 97, i);
+        }
+        std::shuffle(collection.begin(), collection.end(), hasard::engine());
+        cppsort::lsd_radix_sort(collection, &std::pair<int, int>::first);
+        CHECK( std::is_sorted(collection.begin(), collection.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.first < rhs.first;
+        }) );
+    }
+
+    SECTION( "stability with a big enough buffer" )
+    {
+        std::vector<std::pair<int, int>> collection;
+        for (int i = 0 ; i < 10'000 ; ++i) {
+            collection.emplace_back(i % 97, i);
+        }
+        std::shuffle(collection.begin(), collection.end(), hasard::engine());
+        auto expected = collection;
+        std::stable_sort(expected.begin(), expected.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.first < rhs.first;
+        });
+        cppsort::lsd_radix_sort(collection, &std::pair<int, int>::first);
+        CHECK( collection == expected );
+    }
+
+    SECTION( "sort with a fixed buffer" )
+    {
+        std::vector<std::pair<int, int>> collection;
+        for (int i = 0 ; i < 10'000 ; ++i) {
+            collection.emplace_back(i % 97, i);
+        }
+        std::shuffle(collection.begin(), collection.end(), hasard::engine());
+        auto expected = collection;
+        std::stable_sort(expected.begin(), expected.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.first < rhs.first;
+        });
+        cppsort::lsd_radix_sorter<cppsort::utility::fixed_buffer<10'000>>{}(
+            collection, &std::pair<int, int>::first
+        );
+        CHECK( collection == expected );
+    }
+
+    SECTION( "fallback with a small buffer" )
+    {
+        std::vector<int> vec;
+        distribution(std::back_inserter(vec), 10'000, -5'000);
+        cppsort::lsd_radix_sorter<cppsort::utility::fixed_buffer<512>>{}(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/comparators/case_insensitive_less.h>
+#include <cpp-sort/comparators/natural_less.h>
+#include <cpp-sort/sorters/multikey_quick_sorter.h>
+#include <testing-tools/algorithm.h>
+#include <testing-tools/random.h>
+
+TEST_CASE( "multikey_quick_sorter tests", "[multikey_quick_sorter]" )
+{
+    // Strings sharing long prefixes, with numbers of various
+    // lengths and characters of various cases
+    const int size = 5'000;
+    std::vector<std::string> vec;
+    vec.reserve(size);
+    for (int i = 0 ; i < size ; ++i) {
+        std::string str = (i % 2) ? "Item-" : "item-";
+        str += std::to_string(i % 97);
+        str += (i % 3) ? "-Rev" : "-rev";
+        str += std::string(i % 4, '0') + std::to_string(i % 31);
+        vec.push_back(std::move(str));
+    }
+    vec.emplace_back();
+    vec.emplace_back("item-");
+
+    SECTION( "sort with std::less" )
+    {
+        std::shuffle(vec.begin(), vec.end(), hasard::engine());
+        cppsort::multikey_quick_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+
+        std::shuffle(vec.begin(), vec.end(), hasard::engine());
+        cppsort::multikey_quick_sort(vec.begin(), vec.end(), std::less<std::string>{});
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "sort with std::greater" )
+    {
+        std::shuffle(vec.begin(), vec.end(), hasard::engine());
+        cppsort::multikey_quick_sort(vec, std::greater<>{});
+        CHECK( std::is_sorted(vec.begin(), vec.end(), std::greater<>{}) );
+    }
+
+    SECTION( "sort with case_insensitive_less" )
+    {
+        std::shuffle(vec.begin(), vec.end(), hasard::engine());
+        cppsort::multikey_quick_sort(vec, cppsort::case_insensitive_less);
+        CHECK( std::is_sorted(vec.begin(), vec.end(), cppsort::case_insensitive_less) );
+    }
+
+    SECTION( "sort with natural_less" )
+    {
+        std::shuffle(vec.begin(), vec.end(), hasard::engine());
+        cppsort::multikey_quick_sort(vec, cppsort::natural_less);
+        CHECK( std::is_sorted(vec.begin(), vec.end(), cppsort::natural_less) );
+    }
+
+    SECTION( "sort with projection" )
+    {
+        std::vector<std::pair<int, std::string>> pairs;
+        for (auto& str: vec) {
+            pairs.emplace_back(0, std::move(str));
+        }
+        std::shuffle(pairs.begin(), pairs.end(), hasard::engine());
+        cppsort::multikey_quick_sort(pairs, cppsort::natural_less,
+                                     &std::pair<int, std::string>::second);
+        CHECK( helpers::is_sorted(pairs.begin(), pairs.end(), cppsort::natural_less,
+                                  &std::pair<int, std::string>::second) );
+    }
+
+    SECTION( "sort with std::wstring" )
+    {
+        std::vector<std::wstring> wvec;
+        for (auto& str: vec) {
+            wvec.emplace_back(str.begin(), str.end());
+        }
+        std::shuffle(wvec.begin(), wvec.end(), hasard::engine());
+        cppsort::multikey_quick_sort(wvec, cppsort::case_insensitive_less);
+        CHECK( std::is_sorted(wvec.begin(), wvec.end(), cppsort::case_insensitive_less) );
+    }
+}
+
+TEST_CASE( "multikey_quick_sorter against natural_less examples",
+           "[multikey_quick_sorter][comparison]" )
+{
+    std::vector<std::string> vec = {
+        "Yay",
+        "Yay 32 lol",
+        "Yuy 32 lol",
+        "Yay 045",
+        "Yay 01245 huhuhu",
+        "Yay 1234",
+        "x1y10",
+        "x1y9",
+        "x0b",
+        "x00a",
+        "x",
+        "x-",
+        "x:"
+    };
+    std::vector<std::string> expected = {
+        "Yay",
+        "Yay 32 lol",
+        "Yay 045",
+        "Yay 1234",
+        "Yay 01245 huhuhu",
+        "Yuy 32 lol",
+        "x",
+        "x-",
+        "x00a",
+        "x0b",
+        "x1y9",
+        "x1y10",
+        "x:"
+    };
+    cppsort::multikey_quick_sort(vec, cppsort::natural_less);
+    CHECK( vec == expected );
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/sorters/parallel_counting_sorter.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/parallel.h>
+#include <testing-tools/random.h>
+
+TEST_CASE( "parallel_counting_sorter tests", "[parallel_counting_sorter]" )
+{
+    const int size = helpers::parallel_size;
+    auto distribution = dist::shuffled_16_values{};
+
+    SECTION( "sort with int iterable" )
+    {
+        helpers::check_parallel_sort(cppsort::parallel_counting_sort,
+                                     helpers::parallel_collection(distribution));
+    }
+
+    SECTION( "reverse sort with long long iterators" )
+    {
+        std::vector<long long> vec;
+        dist::shuffled{}(std::back_inserter(vec), size, -1568);
+        auto expected = vec;
+        std::sort(expected.begin(), expected.end(), std::greater<>{});
+        cppsort::parallel_counting_sort(vec.begin(), vec.end(), std::greater<>{});
+        CHECK( vec == expected );
+    }
+
+    SECTION( "sort with sorted chunks" )
+    {
+        // Every chunk is sorted, but not the whole collection
+        std::vector<int> vec;
+        dist::ascending{}(std::back_inserter(vec), size);
+        std::rotate(vec.begin(), vec.begin() + size / 2, vec.end());
+        cppsort::parallel_counting_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "sort with sparse values" )
+    {
+        std::vector<long long> vec;
+        distribution(std::back_inserter(vec), size);
+        vec[42] = 1'000'000'000'000;
+        vec[1337] = -1'000'000'000'000;
+        auto expected = vec;
+        std::sort(expected.begin(), expected.end());
+        cppsort::parallel_counting_sort(vec);
+        CHECK( vec == expected );
+
+        std::sort(expected.begin(), expected.end(), std::greater<>{});
+        std::shuffle(vec.begin(), vec.end(), hasard::engine());
+        cppsort::parallel_counting_sort(vec, std::greater<>{});
+        CHECK( vec == expected );
+    }
+}
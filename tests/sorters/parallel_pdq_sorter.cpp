@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/sorters/parallel_pdq_sorter.h>
+#include <testing-tools/algorithm.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/parallel.h>
+#include <testing-tools/wrapper.h>
+
+TEST_CASE( "parallel_pdq_sorter tests", "[parallel_pdq_sorter]" )
+{
+    SECTION( "shuffled" )
+    {
+        helpers::check_parallel_sort(cppsort::parallel_pdq_sort,
+                                     helpers::parallel_collection(dist::shuffled{}, -50'000));
+    }
+
+    SECTION( "shuffled_16_values" )
+    {
+        helpers::check_parallel_sort(cppsort::parallel_pdq_sort,
+                                     helpers::parallel_collection(dist::shuffled_16_values{}));
+    }
+
+    SECTION( "all_equal" )
+    {
+        helpers::check_parallel_sort(cppsort::parallel_pdq_sort,
+                                     helpers::parallel_collection(dist::all_equal{}));
+    }
+
+    SECTION( "descending" )
+    {
+        helpers::check_parallel_sort(cppsort::parallel_pdq_sort,
+                                     helpers::parallel_collection(dist::descending{}));
+    }
+
+    SECTION( "pipe_organ" )
+    {
+        helpers::check_parallel_sort(cppsort::parallel_pdq_sort,
+                                     helpers::parallel_collection(dist::pipe_organ{}));
+    }
+
+    SECTION( "median_of_3_killer" )
+    {
+        helpers::check_parallel_sort(cppsort::parallel_pdq_sort,
+                                     helpers::parallel_collection(dist::median_of_3_killer{}));
+    }
+
+    SECTION( "with comparison and projection" )
+    {
+        std::vector<generic_wrapper<int>> vec;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(vec), helpers::parallel_size);
+        cppsort::parallel_pdq_sort(vec, std::greater<>{}, &generic_wrapper<int>::value);
+        CHECK( helpers::is_sorted(vec.begin(), vec.end(), std::greater<>{},
+                                  &generic_wrapper<int>::value) );
+    }
+
+    SECTION( "exception thrown by a task" )
+    {
+        auto collection = helpers::parallel_collection(dist::shuffled{});
+        auto compare = [](int lhs, int rhs) {
+            if (lhs == 1234 || rhs == 1234) {
+                throw std::runtime_error("comparison failure");
+            }
+            return lhs < rhs;
+        };
+        CHECK_THROWS_AS( cppsort::parallel_pdq_sort(collection, compare), std::runtime_error );
+    }
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/sorters/parallel_ska_sorter.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/parallel.h>
+#include <testing-tools/random.h>
+
+TEST_CASE( "parallel_ska_sorter tests", "[parallel_ska_sorter]" )
+{
+    const int size = helpers::parallel_size;
+    auto distribution = dist::shuffled{};
+
+    SECTION( "sort with int iterable" )
+    {
+        std::vector<int> vec;
+        distribution(std::back_inserter(vec), size, -150'000);
+        cppsort::parallel_ska_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "sort with random 64-bit integers" )
+    {
+        std::vector<std::uint64_t> vec;
+        std::uniform_int_distribution<std::uint64_t> dist;
+        auto&& engine = hasard::engine();
+        for (int i = 0 ; i < size ; ++i) {
+            vec.push_back(dist(engine));
+        }
+        auto expected = vec;
+        std::sort(expected.begin(), expected.end());
+        cppsort::parallel_ska_sort(vec.begin(), vec.end());
+        CHECK( vec == expected );
+    }
+
+    SECTION( "sort with double iterable" )
+    {
+        std::vector<double> vec;
+        distribution.call<double>(std::back_inserter(vec), size, -150'000);
+        cppsort::parallel_ska_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "sort with few distinct values" )
+    {
+        // All the elements share their most significant bytes
+        std::vector<long long> vec;
+        dist::shuffled_16_values{}(std::back_inserter(vec), size);
+        cppsort::parallel_ska_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "sort with std::pair and std::tuple" )
+    {
+        std::vector<std::pair<int, std::string>> pairs;
+        std::vector<std::tuple<short, int, long>> tuples;
+        std::vector<int> values;
+        dist::shuffled_16_values{}(std::back_inserter(values), size);
+        for (int i = 0 ; i < size ; ++i) {
+            pairs.emplace_back(values[i], std::to_string(i % 1000));
+            tuples.emplace_back(static_cast<short>(values[i] * 1000), i % 1000, -i);
+        }
+
+        cppsort::parallel_ska_sort(pairs);
+        CHECK( std::is_sorted(pairs.begin(), pairs.end()) );
+        cppsort::parallel_ska_sort(tuples);
+        CHECK( std::is_sorted(tuples.begin(), tuples.end()) );
+    }
+
+    SECTION( "sort with std::string" )
+    {
+        std::vector<std::string> vec;
+        for (int i = 0 ; i < size ; ++i) {
+            vec.push_back(std::to_string(i));
+        }
+        std::shuffle(vec.begin(), vec.end(), hasard::engine());
+        cppsort::parallel_ska_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+}
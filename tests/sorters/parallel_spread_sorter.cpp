@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/sorters/parallel_spread_sorter.h>
+#include <testing-tools/algorithm.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/parallel.h>
+#include <testing-tools/random.h>
+
+TEST_CASE( "parallel_spread_sorter tests", "[parallel_spread_sorter][spread_sorter]" )
+{
+    const int size = helpers::parallel_size;
+    auto distribution = dist::shuffled{};
+
+    SECTION( "sort with int iterable" )
+    {
+        std::vector<int> vec;
+        distribution(std::back_inserter(vec), size, -100'000);
+        cppsort::parallel_spread_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "sort with unsigned int iterators" )
+    {
+        std::vector<unsigned> vec;
+        distribution(std::back_inserter(vec), size);
+        cppsort::parallel_spread_sort(vec.begin(), vec.end());
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "sort with sparse std::int64_t" )
+    {
+        std::vector<std::int64_t> vec;
+        vec.reserve(size);
+        for (int i = 0 ; i < size ; ++i) {
+            vec.push_back((std::int64_t(i % 1000) - 500) * 1'000'000'007 + i);
+        }
+        std::shuffle(vec.begin(), vec.end(), hasard::engine());
+        cppsort::parallel_spread_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "sort with float iterable" )
+    {
+        std::vector<float> vec;
+        distribution.call<float>(std::back_inserter(vec), size, -100'000);
+        cppsort::parallel_spread_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "sort with double iterators" )
+    {
+        std::vector<double> vec;
+        distribution.call<double>(std::back_inserter(vec), size, -100'000);
+        for (auto& value: vec) {
+            value /= 7.0;
+        }
+        cppsort::parallel_spread_sort(vec.begin(), vec.end());
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "sort with projection" )
+    {
+        std::vector<std::pair<int, float>> vec;
+        for (int i = 0 ; i < size ; ++i) {
+            vec.emplace_back(i - size / 2, float(i - size / 2));
+        }
+        std::shuffle(vec.begin(), vec.end(), hasard::engine());
+        cppsort::parallel_spread_sort(vec, &std::pair<int, float>::first);
+        CHECK( helpers::is_sorted(vec.begin(), vec.end(),
+                                  std::less<>{}, &std::pair<int, float>::second) );
+
+        std::shuffle(vec.begin(), vec.end(), hasard::engine());
+        cppsort::parallel_spread_sort(vec, &std::pair<int, float>::second);
+        CHECK( helpers::is_sorted(vec.begin(), vec.end(),
+                                  std::less<>{}, &std::pair<int, float>::first) );
+    }
+
+    SECTION( "sort with std::string" )
+    {
+        std::vector<std::string> vec;
+        for (int i = 0 ; i < size ; ++i) {
+            vec.push_back(std::to_string(i));
+        }
+
+        std::shuffle(vec.begin(), vec.end(), hasard::engine());
+        cppsort::parallel_spread_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+
+        std::shuffle(vec.begin(), vec.end(), hasard::engine());
+        cppsort::parallel_spread_sort(vec, std::greater<>{});
+        CHECK( std::is_sorted(vec.begin(), vec.end(), std::greater<>{}) );
+    }
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/sorters/spread_sorter/parallel_string_spread_sorter.h>
+#include <testing-tools/algorithm.h>
+#include <testing-tools/parallel.h>
+#include <testing-tools/random.h>
+
+TEST_CASE( "parallel_string_spread_sorter tests",
+           "[parallel_string_spread_sorter][spread_sorter]" )
+{
+    const int size = helpers::parallel_size;
+
+    // Strings sharing a long common prefix, the parallel
+    // passes have to skip it before binning
+    std::vector<std::string> vec;
+    vec.reserve(size);
+    for (int i = 0 ; i < size ; ++i) {
+        vec.push_back("https://example.com/" + std::to_string(i * 7919 % 1000));
+        vec.back() += '/' + std::to_string(i);
+    }
+
+    SECTION( "sort with std::string" )
+    {
+        std::shuffle(vec.begin(), vec.end(), hasard::engine());
+        cppsort::parallel_string_spread_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+
+        std::shuffle(vec.begin(), vec.end(), hasard::engine());
+        cppsort::parallel_string_spread_sort(vec.begin(), vec.end());
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "reverse sort with std::string" )
+    {
+        std::shuffle(vec.begin(), vec.end(), hasard::engine());
+        cppsort::parallel_string_spread_sort(vec, std::greater<>{});
+        CHECK( std::is_sorted(vec.begin(), vec.end(), std::greater<>{}) );
+    }
+
+    SECTION( "empty strings and duplicates" )
+    {
+        for (int i = 0 ; i < size ; i += 3) {
+            vec[i].clear();
+        }
+        for (int i = 1 ; i < size ; i += 5) {
+            vec[i] = "https://example.com/";
+        }
+
+        auto reversed = vec;
+        std::shuffle(vec.begin(), vec.end(), hasard::engine());
+        cppsort::parallel_string_spread_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+
+        std::shuffle(reversed.begin(), reversed.end(), hasard::engine());
+        cppsort::parallel_string_spread_sort(reversed, std::greater<>{});
+        CHECK( std::is_sorted(reversed.begin(), reversed.end(), std::greater<>{}) );
+    }
+
+    SECTION( "sort with projection" )
+    {
+        std::vector<std::pair<std::string, int>> pairs;
+        pairs.reserve(size);
+        for (int i = 0 ; i < size ; ++i) {
+            pairs.emplace_back(std::move(vec[i]), i);
+        }
+        std::shuffle(pairs.begin(), pairs.end(), hasard::engine());
+        cppsort::parallel_string_spread_sort(pairs, &std::pair<std::string, int>::first);
+        CHECK( helpers::is_sorted(pairs.begin(), pairs.end(),
+                                  std::less<>{}, &std::pair<std::string, int>::first) );
+    }
+}
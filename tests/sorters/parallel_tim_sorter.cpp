@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <type_traits>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/adapters/stable_adapter.h>
+#include <cpp-sort/sorters/parallel_tim_sorter.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/parallel.h>
+
+TEST_CASE( "parallel_tim_sorter tests", "[parallel_tim_sorter]" )
+{
+    SECTION( "shuffled" )
+    {
+        helpers::check_parallel_sort(cppsort::parallel_tim_sort,
+                                     helpers::parallel_collection(dist::shuffled{}, -50'000));
+    }
+
+    SECTION( "descending" )
+    {
+        helpers::check_parallel_sort(cppsort::parallel_tim_sort,
+                                     helpers::parallel_collection(dist::descending{}));
+    }
+
+    SECTION( "mostly sorted" )
+    {
+        helpers::check_parallel_sort(cppsort::parallel_tim_sort,
+                                     helpers::parallel_mostly_sorted_collection());
+    }
+
+    SECTION( "stability" )
+    {
+        helpers::check_parallel_stability(cppsort::parallel_tim_sort);
+    }
+
+    SECTION( "stable_adapter is a no-op" )
+    {
+        STATIC_CHECK( std::is_same<
+            cppsort::stable_t<cppsort::parallel_tim_sorter>,
+            cppsort::parallel_tim_sorter
+        >::value );
+    }
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/adapters/stable_adapter.h>
+#include <cpp-sort/sorters/parallel_verge_sorter.h>
+#include <testing-tools/algorithm.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/parallel.h>
+#include <testing-tools/wrapper.h>
+
+using wrapper = generic_stable_wrapper<int>;
+
+TEST_CASE( "parallel_verge_sorter tests", "[parallel_verge_sorter]" )
+{
+    SECTION( "shuffled" )
+    {
+        helpers::check_parallel_sort(cppsort::parallel_verge_sort,
+                                     helpers::parallel_collection(dist::shuffled{}, -50'000));
+    }
+
+    SECTION( "runs crossing chunk boundaries" )
+    {
+        // Big ascending and descending runs separated by
+        // unsorted segments, in no particular alignment
+        auto collection = helpers::parallel_collection(dist::shuffled{});
+        std::sort(collection.begin() + 3'000, collection.begin() + 70'000);
+        std::sort(collection.begin() + 75'000, collection.begin() + 160'000, std::greater<>{});
+        std::sort(collection.begin() + 160'000, collection.end());
+        helpers::check_parallel_sort(cppsort::parallel_verge_sort, collection);
+    }
+
+    SECTION( "descending" )
+    {
+        helpers::check_parallel_sort(cppsort::parallel_verge_sort,
+                                     helpers::parallel_collection(dist::descending{}));
+    }
+
+    SECTION( "descending_plateau with greater" )
+    {
+        helpers::check_parallel_sort(cppsort::parallel_verge_sort,
+                                     helpers::parallel_collection(dist::descending_plateau{}),
+                                     std::greater<>{});
+    }
+
+    SECTION( "stable_adapter specialization" )
+    {
+        // Descending runs with equivalent elements and sorted
+        // runs spanning several chunks
+        const int size = helpers::parallel_size;
+        std::vector<wrapper> collection(size);
+        helpers::iota(collection.begin(), collection.end(), 0, &wrapper::order);
+        for (int idx = 0 ; idx < size ; ++idx) {
+            collection[idx].value = idx < 120'000 ? (size - idx) / 3 : idx % 16;
+        }
+        cppsort::stable_t<cppsort::parallel_verge_sorter>{}(collection, &wrapper::value);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <type_traits>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/adapters/stable_adapter.h>
+#include <cpp-sort/sorters/parallel_wiki_sorter.h>
+#include <cpp-sort/utility/buffer.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/parallel.h>
+
+TEST_CASE( "parallel_wiki_sorter tests", "[parallel_wiki_sorter]" )
+{
+    SECTION( "shuffled" )
+    {
+        helpers::check_parallel_sort(cppsort::parallel_wiki_sort,
+                                     helpers::parallel_collection(dist::shuffled{}, -50'000));
+    }
+
+    SECTION( "descending" )
+    {
+        helpers::check_parallel_sort(cppsort::parallel_wiki_sort,
+                                     helpers::parallel_collection(dist::descending{}));
+    }
+
+    SECTION( "without a cache" )
+    {
+        using sorter = cppsort::parallel_wiki_sorter<
+            cppsort::utility::fixed_buffer<0>
+        >;
+        helpers::check_parallel_sort(sorter{},
+                                     helpers::parallel_collection(dist::pipe_organ{}));
+    }
+
+    SECTION( "stability" )
+    {
+        helpers::check_parallel_stability(cppsort::parallel_wiki_sort);
+    }
+
+    SECTION( "stable_adapter is a no-op" )
+    {
+        STATIC_CHECK( std::is_same<
+            cppsort::stable_t<cppsort::parallel_wiki_sorter<>>,
+            cppsort::parallel_wiki_sorter<>
+        >::value );
+    }
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <testing-tools/distributions.h>
+
+namespace
+{
+    template<typename T, typename Distribution, typename... Args>
+    auto pdq_sort_arithmetic(Distribution distribution, Args... args)
+        -> bool
+    {
+        std::vector<T> collection;
+        distribution.template call<T>(std::back_inserter(collection), 10'000);
+        auto expected = collection;
+        std::sort(expected.begin(), expected.end(), args...);
+
+        // Iterators and pointers can take different paths
+        auto vec = collection;
+        cppsort::pdq_sort(vec.begin(), vec.end(), args...);
+        auto ptr = collection;
+        cppsort::pdq_sort(ptr.data(), ptr.data() + ptr.size(), args...);
+        return vec == expected && ptr == expected;
+    }
+
+    template<typename T, typename Distribution>
+    auto pdq_sort_arithmetic_both_orders(Distribution distribution)
+        -> bool
+    {
+        return pdq_sort_arithmetic<T>(distribution)
+            && pdq_sort_arithmetic<T>(distribution, std::greater<>{});
+    }
+}
+
+TEST_CASE( "pdq_sorter with arithmetic types", "[pdq_sorter]" )
+{
+    // The partitioning step may use SIMD instructions for
+    // such types when the target instruction set allows it
+
+    SECTION( "shuffled" )
+    {
+        auto distribution = dist::shuffled{};
+        CHECK( pdq_sort_arithmetic_both_orders<std::int32_t>(distribution) );
+        CHECK( pdq_sort_arithmetic_both_orders<std::uint32_t>(distribution) );
+        CHECK( pdq_sort_arithmetic_both_orders<std::int64_t>(distribution) );
+        CHECK( pdq_sort_arithmetic_both_orders<std::uint64_t>(distribution) );
+        CHECK( pdq_sort_arithmetic_both_orders<float>(distribution) );
+        CHECK( pdq_sort_arithmetic_both_orders<double>(distribution) );
+    }
+
+    SECTION( "shuffled_16_values" )
+    {
+        auto distribution = dist::shuffled_16_values{};
+        CHECK( pdq_sort_arithmetic_both_orders<std::int32_t>(distribution) );
+        CHECK( pdq_sort_arithmetic_both_orders<std::uint32_t>(distribution) );
+        CHECK( pdq_sort_arithmetic_both_orders<std::int64_t>(distribution) );
+        CHECK( pdq_sort_arithmetic_both_orders<std::uint64_t>(distribution) );
+        CHECK( pdq_sort_arithmetic_both_orders<float>(distribution) );
+        CHECK( pdq_sort_arithmetic_both_orders<double>(distribution) );
+    }
+
+    SECTION( "pipe_organ" )
+    {
+        auto distribution = dist::pipe_organ{};
+        CHECK( pdq_sort_arithmetic_both_orders<std::int32_t>(distribution) );
+        CHECK( pdq_sort_arithmetic_both_orders<std::uint64_t>(distribution) );
+        CHECK( pdq_sort_arithmetic_both_orders<float>(distribution) );
+    }
+}
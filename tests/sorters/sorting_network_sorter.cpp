@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/fixed/sorting_network_sorter.h>
+#include <testing-tools/distributions.h>
+
+namespace
+{
+    template<typename T, std::size_t N, typename... Args>
+    auto sort_with_network(Args&&... args)
+        -> bool
+    {
+        std::vector<T> collection;
+        auto distribution = dist::shuffled{};
+        distribution.call<T>(std::back_inserter(collection), 64, -10);
+        collection.resize(N);
+        auto expected = collection;
+        std::sort(expected.begin(), expected.end(), args...);
+
+        // Iterators and pointers can take different paths
+        auto vec = collection;
+        cppsort::sorting_network_sorter<N>{}(vec.begin(), vec.end(), args...);
+        auto ptr = collection;
+        cppsort::sorting_network_sorter<N>{}(ptr.data(), ptr.data() + N, args...);
+        return vec == expected && ptr == expected;
+    }
+
+    template<typename T, typename... Args, std::size_t... Indices>
+    auto sort_with_every_network(std::index_sequence<Indices...>, Args&&... args)
+        -> bool
+    {
+        bool results[] = { sort_with_network<T, Indices>(args...)... };
+        return std::all_of(std::begin(results), std::end(results), [](bool res) { return res; });
+    }
+}
+
+TEST_CASE( "sorting_network_sorter with arithmetic types",
+           "[sorting_network_sorter]" )
+{
+    // Some sizes and types can be sorted with SIMD kernels
+    // when the target instruction set allows it
+
+    using indices = std::make_index_sequence<33>;
+
+    SECTION( "std::int32_t" )
+    {
+        CHECK( sort_with_every_network<std::int32_t>(indices{}) );
+        CHECK( sort_with_every_network<std::int32_t>(indices{}, std::greater<>{}) );
+    }
+
+    SECTION( "std::int64_t" )
+    {
+        CHECK( sort_with_every_network<std::int64_t>(indices{}) );
+        CHECK( sort_with_every_network<std::int64_t>(indices{}, std::greater<>{}) );
+    }
+
+    SECTION( "float" )
+    {
+        CHECK( sort_with_every_network<float>(indices{}) );
+        CHECK( sort_with_every_network<float>(indices{}, std::greater<>{}) );
+    }
+
+    SECTION( "double" )
+    {
+        CHECK( sort_with_every_network<double>(indices{}) );
+        CHECK( sort_with_every_network<double>(indices{}, std::greater<>{}) );
+    }
+}
+
+TEST_CASE( "sorting_network_sorter with equivalent elements",
+           "[sorting_network_sorter]" )
+{
+    std::vector<float> collection;
+    auto distribution = dist::shuffled_16_values{};
+    distribution.call<float>(std::back_inserter(collection), 32);
+    cppsort::sorting_network_sorter<32>{}(collection);
+    CHECK( std::is_sorted(collection.begin(), collection.end()) );
+
+    // -0.0 and 0.0 compare equivalent
+    std::vector<float> zeros = { 0.0f, -0.0f, 1.0f, -0.0f, 0.0f, -1.0f, 0.0f, -0.0f, 0.0f };
+    cppsort::sorting_network_sorter<9>{}(zeros);
+    CHECK( std::is_sorted(zeros.begin(), zeros.end()) );
+}
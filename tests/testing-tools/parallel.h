@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2022 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_TESTSUITE_PARALLEL_H_
+#define CPPSORT_TESTSUITE_PARALLEL_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include "algorithm.h"
+#include "distributions.h"
+#include "wrapper.h"
+
+////////////////////////////////////////////////////////////
+// Checks shared by the parallel sorters tests
+//
+// The test suite defines CPPSORT_THREAD_POOL_SIZE so that
+// the parallel algorithms run with several threads even on
+// machines with a single core, and the collections are big
+// enough to be split into several chunks handled by different
+// tasks: every parallel algorithm of the library switches to
+// its sequential fallback below 1 << 16 elements at most.
+//
+
+namespace helpers
+{
+    constexpr int parallel_size = 200'000;
+
+    template<typename Distribution, typename... Args>
+    auto parallel_collection(Distribution distribution, Args... args)
+        -> std::vector<int>
+    {
+        std::vector<int> collection;
+        collection.reserve(parallel_size);
+        distribution(std::back_inserter(collection), parallel_size, args...);
+        return collection;
+    }
+
+    // Ascending collection with a few out-of-place values and
+    // a sorted sequence cut by the chunk boundaries
+    inline auto parallel_mostly_sorted_collection()
+        -> std::vector<int>
+    {
+        auto collection = parallel_collection(dist::ascending_sawtooth{});
+        std::sort(collection.begin(), collection.end());
+        for (int idx = 0 ; idx < parallel_size ; idx += 997) {
+            collection[idx] = (idx * 7919) % parallel_size;
+        }
+        return collection;
+    }
+
+    // Checks that the sorter produces the same result as
+    // std::stable_sort, which also checks that no element
+    // was lost or duplicated when merging the chunks
+    template<typename Sorter, typename Compare=std::less<>>
+    auto check_parallel_sort(const Sorter& sorter, std::vector<int> collection,
+                             Compare compare={})
+        -> void
+    {
+        auto expected = collection;
+        std::stable_sort(expected.begin(), expected.end(), compare);
+        sorter(collection, compare);
+        CHECK( collection == expected );
+    }
+
+    // Checks the stability of the sorter across chunks: a
+    // small number of distinct values guarantees that equal
+    // elements end up in different chunks
+    template<typename Sorter>
+    auto check_parallel_stability(const Sorter& sorter)
+        -> void
+    {
+        using wrapper = generic_stable_wrapper<int>;
+        std::vector<wrapper> collection(parallel_size);
+        helpers::iota(collection.begin(), collection.end(), 0, &wrapper::order);
+        auto distribution = dist::shuffled_16_values{};
+        distribution(collection.begin(), collection.size());
+        sorter(collection, &wrapper::value);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+}
+
+#endif // CPPSORT_TESTSUITE_PARALLEL_H_